@@ -2,12 +2,18 @@
 
 #include "concepts.h"
 #include "polynomial.h"
+#include "dense.h"
+#include "division.h"
+#include "interreduction.h"
+#include "streams.h"
 
+#include <functional>
 #include <optional>
+#include <type_traits>
 
 namespace GB {
 
-Monomial Lcm(const Monomial &first, const Monomial &second) {
+inline Monomial Lcm(const Monomial &first, const Monomial &second) {
     Monomial::DegreeVector result(std::max(first.GetAmountOfVariables(), second.GetAmountOfVariables()));
     for (Monomial::IndexType index = 0; index < result.size(); ++index) {
         result[index] = std::max(first.GetDegree(index), second.GetDegree(index));
@@ -28,6 +34,23 @@ Polynomial<FieldType, MonomialOrder> SPolynomial (
     return termsLCM / l1.first * first * l2.second - termsLCM / l2.first * second * l1.second;
 }
 
+// S-polynomial of two elements as a stream, its leading terms cancel on the fly.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+auto SPolynomialStream(
+        const Polynomial<FieldType, MonomialOrder> &first,
+        const Polynomial<FieldType, MonomialOrder> &second)
+{
+    using Stream = ScaledTermStream<PolynomialTermStream<FieldType, MonomialOrder>>;
+
+    const auto &l1 = first.GetLeadingTerm();
+    const auto &l2 = second.GetLeadingTerm();
+    const auto termsLCM = Lcm(l1.first, l2.first);
+
+    return SumTermStream<Stream, Stream>(
+            Stream(PolynomialTermStream<FieldType, MonomialOrder>(first), termsLCM / l1.first, l2.second),
+            Stream(PolynomialTermStream<FieldType, MonomialOrder>(second), termsLCM / l2.first, -l1.second));
+}
+
 template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
 bool ElementaryReduction(
         Polynomial<FieldType, MonomialOrder> &reducible,
@@ -46,7 +69,9 @@ bool ElementaryReduction(
             termToDivide->second / other.GetLeadingTerm().second
     };
 
-    reducible -= Polynomial(quotient) * other;
+    using Stream = PolynomialTermStream<FieldType, MonomialOrder>;
+    reducible = Collect(SumTermStream(Stream(reducible),
+                                      ScaledTermStream(Stream(other), quotient.first, -quotient.second)));
 
     return true;
 }
@@ -78,14 +103,27 @@ size_t ReductionOverSet(
     return reductionCount;
 }
 
+// How S-polynomials are reduced over the basis, and where the reducer choices are counted.
+struct ReducerPolicy {
+    ReducerSelection selection = ReducerSelection::kFirst;
+    ReductionStatistics *statistics = nullptr;
+    // Reduce in a dense coefficient array by the first eligible divisor, the selection is ignored.
+    bool isDense = false;
+};
+
+// Computes the full remainder in one pass through the heap division, so the
+// intermediate products quotient * divisor are never materialized.
 template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
 size_t ChainOfReductionsOverSet(
         Polynomial<FieldType, MonomialOrder> &reducible,
-        const PolynomialSet<FieldType, MonomialOrder> &other)
+        const PolynomialSet<FieldType, MonomialOrder> &other,
+        const ReducerPolicy &policy = {})
 {
-    size_t overallReductionCount = 0, lastReductionCount;
-    while ((lastReductionCount = ReductionOverSet(reducible, other)) != 0) {
-        overallReductionCount += lastReductionCount;
+    size_t overallReductionCount = 0;
+    if (policy.isDense) {
+        reducible = DenseReduction(reducible, other, &overallReductionCount, policy.statistics);
+    } else {
+        reducible = HeapReduction(reducible, other, &overallReductionCount, policy.selection, policy.statistics);
     }
 
     return overallReductionCount;
@@ -102,19 +140,29 @@ bool CheckLeadingTermsCoprime(
     return l1 * l2 == Lcm(l1, l2);
 }
 
+// Cheap test that the S-polynomial of two elements reduces to zero, so its reduction is skipped.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+using ZeroReductionFilter = std::function<bool(const Polynomial<FieldType, MonomialOrder> &,
+                                               const Polynomial<FieldType, MonomialOrder> &)>;
+
 template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
 std::optional<Polynomial<FieldType, MonomialOrder>> CheckPair(
         const Polynomial<FieldType, MonomialOrder> &first,
         const Polynomial<FieldType, MonomialOrder> &second,
-        const PolynomialSet<FieldType, MonomialOrder> &set)
+        const PolynomialSet<FieldType, MonomialOrder> &set,
+        const std::type_identity_t<ZeroReductionFilter<FieldType, MonomialOrder>> &filter = {},
+        const ReducerPolicy &policy = {})
 {
     if (CheckLeadingTermsCoprime(first, second)) {
         return std::nullopt;
     }
 
-    auto S = SPolynomial(first, second);
+    if (filter && filter(first, second)) {
+        return std::nullopt;
+    }
 
-    ChainOfReductionsOverSet(S, set);
+    auto S = policy.isDense ? DenseReduction(SPolynomial(first, second), set, nullptr, policy.statistics) :
+             HeapReduction(SPolynomialStream(first, second), set, nullptr, policy.selection, policy.statistics);
     if (S == Polynomial<FieldType, MonomialOrder>(0)) {
         return std::nullopt;
     } else {
@@ -123,7 +171,11 @@ std::optional<Polynomial<FieldType, MonomialOrder>> CheckPair(
 }
 
 template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
-PolynomialSet<FieldType, MonomialOrder> FindPairs(const PolynomialSet<FieldType, MonomialOrder> &set) {
+PolynomialSet<FieldType, MonomialOrder> FindPairs(
+        const PolynomialSet<FieldType, MonomialOrder> &set,
+        const std::type_identity_t<ZeroReductionFilter<FieldType, MonomialOrder>> &filter = {},
+        const ReducerPolicy &policy = {})
+{
     PolynomialSet<FieldType, MonomialOrder> suitablePairs;
 
     for (const auto &first : set) {
@@ -132,7 +184,7 @@ PolynomialSet<FieldType, MonomialOrder> FindPairs(const PolynomialSet<FieldType,
                 break;
             }
 
-            auto S = CheckPair(first, second, set);
+            auto S = CheckPair(first, second, set, filter, policy);
             if (S.has_value()) {
                 suitablePairs.insert(*S);
             }
@@ -191,16 +243,39 @@ void OptimizeSet(PolynomialSet<FieldType, MonomialOrder> &set) {
     NormalizeSetCoefficients(set);
 }
 
+// The set is a Gröbner basis before the last interreduction, so that one may run in parallel.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+void FinalInterreduction(PolynomialSet<FieldType, MonomialOrder> &set, size_t amountOfThreads) {
+    if (amountOfThreads == 1) {
+        OptimizeSet(set);
+    } else {
+        ParallelInterreduction(set, amountOfThreads);
+    }
+}
+
+// Threads of the final interreduction, 0 means std::thread::hardware_concurrency and
+// 1 keeps the sequential OptimizeSet.
 template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
-void BuhbergerAlgorithm(PolynomialSet<FieldType, MonomialOrder> &set) {
-    auto polynomialsToAdd = FindPairs(set);
-    OptimizeSet(set);
+void BuhbergerAlgorithm(
+        PolynomialSet<FieldType, MonomialOrder> &set,
+        const ReducerPolicy &policy = {},
+        size_t interreductionThreads = 1)
+{
+    // The default policy keeps the one-argument call, so field specific FindPairs overloads are found.
+    auto findPairs = [&] {
+        if (policy.selection == ReducerSelection::kFirst && policy.statistics == nullptr && !policy.isDense) {
+            return FindPairs(set);
+        }
+        return FindPairs(set, {}, policy);
+    };
 
+    auto polynomialsToAdd = findPairs();
     while (!polynomialsToAdd.empty()) {
-        set.merge(polynomialsToAdd);
-        polynomialsToAdd = FindPairs(set);
         OptimizeSet(set);
+        set.merge(polynomialsToAdd);
+        polynomialsToAdd = findPairs();
     }
+    FinalInterreduction(set, interreductionThreads);
 }
 
 
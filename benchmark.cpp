@@ -0,0 +1,521 @@
+#include <cassert>
+#include <climits>
+
+#include "benchmark.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "modular.h"
+#include "rational.h"
+#include "strategy.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace GB {
+
+namespace {
+
+    using WordPrimeField = Modular<2147483647>;
+    using LargePrimeField = LargeModular<4611686018427387847>;
+
+    template<typename Function>
+    double MeasureSeconds(Function &&function, int repetitions = 1) {
+        auto start = std::chrono::steady_clock::now();
+        for (int repetition = 0; repetition < repetitions; ++repetition) {
+            function();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / repetitions;
+    }
+
+    // cyclic-n: the sums of all products of k cyclically consecutive variables, and x_0 ... x_{n-1} - 1.
+    template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+    PolynomialSet<FieldType, MonomialOrder> Cyclic(size_t amountOfVariables) {
+        using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+
+        PolynomialSet<FieldType, MonomialOrder> result;
+        for (size_t length = 1; length <= amountOfVariables; ++length) {
+            PolynomialType polynomial;
+            for (size_t start = 0; start < (length == amountOfVariables ? 1 : amountOfVariables); ++start) {
+                Monomial::DegreeVector degrees(amountOfVariables);
+                for (size_t offset = 0; offset < length; ++offset) {
+                    degrees[(start + offset) % amountOfVariables] = 1;
+                }
+                polynomial += PolynomialType(Monomial(std::move(degrees)));
+            }
+            if (length == amountOfVariables) {
+                polynomial -= PolynomialType(FieldType(1));
+            }
+            result.insert(std::move(polynomial));
+        }
+
+        return result;
+    }
+
+    // katsura-3: u_0 + 2 u_1 + 2 u_2 + 2 u_3 - 1 and three quadrics, one generator is linear.
+    template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+    PolynomialSet<FieldType, MonomialOrder> Katsura3() {
+        using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+
+        return {
+            PolynomialType({{{1}, 1}, {{0, 1}, 2}, {{0, 0, 1}, 2}, {{0, 0, 0, 1}, 2}, {{}, -1}}),
+            PolynomialType({{{2}, 1}, {{0, 2}, 2}, {{0, 0, 2}, 2}, {{0, 0, 0, 2}, 2}, {{1}, -1}}),
+            PolynomialType({{{1, 1}, 2}, {{0, 1, 1}, 2}, {{0, 0, 1, 1}, 2}, {{0, 1}, -1}}),
+            PolynomialType({{{0, 2}, 1}, {{1, 0, 1}, 2}, {{0, 1, 0, 1}, 2}, {{0, 0, 1}, -1}})
+        };
+    }
+
+    // Generators with random terms of degree at most maxDegree and coefficients in [-bound, bound].
+    template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+    PolynomialSet<FieldType, MonomialOrder> RandomSystem(uint64_t seed, size_t amountOfVariables,
+                                                         size_t amountOfGenerators, size_t maxDegree,
+                                                         size_t amountOfTerms, int bound)
+    {
+        using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+        std::mt19937_64 generator(seed);
+
+        PolynomialSet<FieldType, MonomialOrder> result;
+        while (result.size() < amountOfGenerators) {
+            PolynomialType polynomial;
+            for (size_t term = 0; term < amountOfTerms; ++term) {
+                Monomial::DegreeVector degrees(amountOfVariables);
+                for (size_t factor = generator() % (maxDegree + 1); factor > 0; --factor) {
+                    degrees[generator() % amountOfVariables] += 1;
+                }
+                int coefficient = static_cast<int>(generator() % (2 * bound + 1)) - bound;
+                polynomial += PolynomialType(typename PolynomialType::Term(Monomial(std::move(degrees)),
+                                                                           FieldType(coefficient == 0 ? 1 : coefficient)));
+            }
+            if (!PolynomialType::IsZero(polynomial)) {
+                result.insert(std::move(polynomial));
+            }
+        }
+
+        return result;
+    }
+
+    // The set together with a copy of it in the variables shifted by offset.
+    template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+    PolynomialSet<FieldType, MonomialOrder> WithDisjointCopy(const PolynomialSet<FieldType, MonomialOrder> &set,
+                                                             size_t offset)
+    {
+        using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+
+        auto result = set;
+        for (const auto &polynomial : set) {
+            PolynomialType copy;
+            for (const auto &[monomial, coefficient] : polynomial) {
+                Monomial::DegreeVector degrees(offset);
+                degrees.insert(degrees.end(), monomial.GetDegrees().begin(), monomial.GetDegrees().end());
+                copy += PolynomialType(typename PolynomialType::Term(Monomial(std::move(degrees)), coefficient));
+            }
+            result.insert(std::move(copy));
+        }
+
+        return result;
+    }
+
+    template<typename FieldType>
+    double MeasureMultiplyAccumulate(size_t size) {
+        std::vector<FieldType> lhs(size), rhs(size);
+        for (size_t index = 0; index < size; ++index) {
+            lhs[index] = FieldType(static_cast<int64_t>(index * 2654435761u + 1));
+            rhs[index] = FieldType(static_cast<int64_t>(index * 40503u + 7));
+        }
+
+        FieldType sum = 0;
+        double seconds = MeasureSeconds([&] {
+            for (size_t index = 0; index < size; ++index) {
+                sum += lhs[index] * rhs[index];
+            }
+        }, 20);
+        // Keeps the loop from being optimized away.
+        if (sum == FieldType(-1)) {
+            std::cout << "";
+        }
+
+        return seconds / size * 1e9;
+    }
+
+    template<SuitableFieldType FieldType>
+    double MeasureBasis(size_t amountOfVariables) {
+        return MeasureSeconds([&] {
+            auto set = Cyclic<FieldType, GradedReverseLexicographicalOrder>(amountOfVariables);
+            BuhbergerAlgorithm(set);
+        });
+    }
+
+    // Multi-modular reconstruction of a rational with numerator and denominator below 2^bits
+    // needs the product of the primes to exceed 2^{2 bits + 1}.
+    size_t AmountOfPrimes(size_t bits, size_t bitsPerPrime) {
+        return (2 * bits + 1 + bitsPerPrime - 1) / bitsPerPrime;
+    }
+
+    void BenchmarkPrimeFields() {
+        constexpr size_t kVectorSize = 1 << 20;
+        constexpr size_t kAmountOfVariables = 4;
+
+        double wordOperation = MeasureMultiplyAccumulate<WordPrimeField>(kVectorSize);
+        double largeOperation = MeasureMultiplyAccumulate<LargePrimeField>(kVectorSize);
+        double wordBasis = MeasureBasis<WordPrimeField>(kAmountOfVariables);
+        double largeBasis = MeasureBasis<LargePrimeField>(kAmountOfVariables);
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Prime fields: 31-bit Modular vs 62-bit LargeModular\n";
+        std::cout << "  multiply-accumulate, ns/op: " << wordOperation << " vs " << largeOperation << "\n";
+        std::cout << "  cyclic-" << kAmountOfVariables << " basis, ms: " << wordBasis * 1e3 << " vs " << largeBasis * 1e3 << "\n";
+
+        for (size_t bits : {32, 128, 512, 2048}) {
+            size_t wordPrimes = AmountOfPrimes(bits, 30);
+            size_t largePrimes = AmountOfPrimes(bits, 61);
+            std::cout << "  coefficients of " << bits << " bits: " << wordPrimes << " vs " << largePrimes
+                      << " primes, estimated ms: " << wordPrimes * wordBasis * 1e3
+                      << " vs " << largePrimes * largeBasis * 1e3 << "\n";
+        }
+    }
+
+    // Total timings over a family of inputs of every pass of BuchbergerOptions on its own,
+    // and of the automatic choice.
+    template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+    void CompareStrategies(const std::string &name, const std::vector<PolynomialSet<FieldType, MonomialOrder>> &family) {
+        auto measure = [&] (auto &&compute) {
+            return MeasureSeconds([&] {
+                for (const auto &set : family) {
+                    auto basis = set;
+                    compute(basis);
+                }
+            }) * 1e3;
+        };
+        auto measureOptions = [&] (const BuchbergerOptions &options) {
+            return measure([&] (auto &basis) {
+                BuhbergerAlgorithm(basis, options);
+            });
+        };
+
+        BuchbergerOptions direct, elimination, decomposition, lifting, preFilter;
+        direct.amountOfThreads = 1;
+        elimination.eliminateLinearEquations = true;
+        decomposition.decomposeComponents = true;
+        lifting.usePAdicLifting = true;
+        preFilter.useModularPreFilter = true;
+        preFilter.seed = 1;
+
+        std::cout << "  " << name << ", ms: direct " << measureOptions(direct)
+                  << ", elimination " << measureOptions(elimination)
+                  << ", decomposition " << measureOptions(decomposition);
+        if constexpr (std::is_same_v<FieldType, Rational<>>) {
+            std::cout << ", lifting " << measureOptions(lifting) << ", pre-filter " << measureOptions(preFilter);
+        }
+        std::cout << ", auto " << measure([] (auto &basis) {
+            AutoBuhbergerAlgorithm(basis);
+        }) << "\n";
+    }
+
+    void BenchmarkStrategies() {
+        using Order = GradedReverseLexicographicalOrder;
+
+        std::vector<PolynomialSet<WordPrimeField, Order>> modularCopies;
+        std::vector<PolynomialSet<Rational<>, Order>> smallRational, rational;
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            modularCopies.push_back(WithDisjointCopy(RandomSystem<WordPrimeField, Order>(seed, 4, 4, 2, 3, 10), 4));
+            smallRational.push_back(RandomSystem<Rational<>, Order>(seed, 2, 2, 2, 3, 3));
+            // Larger seeds overflow 64-bit rationals in the direct computation.
+            rational.push_back(RandomSystem<Rational<>, Order>(seed, 4, 4, 2, 3, 10));
+        }
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Strategies\n";
+        CompareStrategies("katsura-3 mod p, lex", std::vector{Katsura3<WordPrimeField, LexicographicalOrder>()});
+        CompareStrategies("katsura-3 mod p, two copies", std::vector{WithDisjointCopy(Katsura3<WordPrimeField, Order>(), 4)});
+        CompareStrategies("20 random 4x4 quadrics mod p, two copies", modularCopies);
+        CompareStrategies("20 random 2x2 quadrics over Q", smallRational);
+        CompareStrategies("20 random 4x4 quadrics over Q", rational);
+    }
+
+    void BenchmarkReducerSelection() {
+        using Order = GradedReverseLexicographicalOrder;
+
+        std::vector<PolynomialSet<Rational<>, Order>> family;
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            family.push_back(RandomSystem<Rational<>, Order>(seed, 4, 4, 2, 3, 10));
+        }
+
+        std::cout << "Reducer selection, 20 random 4x4 quadrics over Q\n";
+        std::pair<const char *, ReducerSelection> selections[] = {
+            {"first", ReducerSelection::kFirst},
+            {"shortest", ReducerSelection::kShortest},
+            {"lowest sugar", ReducerSelection::kLowestSugar},
+            {"smallest coefficients", ReducerSelection::kSmallestCoefficients},
+            {"most recent", ReducerSelection::kMostRecent}
+        };
+        for (const auto &[name, selection] : selections) {
+            ReductionStatistics statistics;
+            BuchbergerOptions options;
+            options.reducerSelection = selection;
+            options.statistics = &statistics;
+
+            double seconds = MeasureSeconds([&] {
+                for (const auto &set : family) {
+                    auto basis = set;
+                    BuhbergerAlgorithm(basis, options);
+                }
+            });
+            std::cout << "  " << name << ": " << seconds * 1e3 << " ms, " << statistics.reductions << " reductions, "
+                      << statistics.redirectedReductions << " of " << statistics.ambiguousReductions
+                      << " ambiguous ones redirected\n";
+        }
+    }
+
+    void BenchmarkMultipleCache() {
+        using Order = GradedReverseLexicographicalOrder;
+
+        std::vector<PolynomialSet<Rational<>, Order>> family;
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            family.push_back(RandomSystem<Rational<>, Order>(seed, 4, 4, 2, 3, 10));
+        }
+        auto katsura = Katsura3<WordPrimeField, Order>();
+
+        std::cout << "Monomial multiple cache\n";
+        std::pair<const char *, size_t> modes[] = {{"off", 0}, {"products", 1}, {"simplified products", 2}};
+        for (const auto &[name, mode] : modes) {
+            MultipleCacheStatistics rationalStatistics, katsuraStatistics;
+            BuchbergerOptions options;
+            options.multipleCacheTerms = mode == 0 ? 0 : 1 << 20;
+            options.simplifyMultiples = mode == 2;
+
+            options.multipleCacheStatistics = &rationalStatistics;
+            double rational = MeasureSeconds([&] {
+                for (const auto &set : family) {
+                    auto basis = set;
+                    BuhbergerAlgorithm(basis, options);
+                }
+            });
+            options.multipleCacheStatistics = &katsuraStatistics;
+            double modular = MeasureSeconds([&] {
+                auto basis = katsura;
+                BuhbergerAlgorithm(basis, options);
+            });
+
+            std::cout << "  " << name << ": 20 random 4x4 over Q " << rational * 1e3 << " ms, hit rate "
+                      << rationalStatistics.GetHitRate() << "; katsura-3 mod p " << modular * 1e3
+                      << " ms, hit rate " << katsuraStatistics.GetHitRate() << "\n";
+        }
+    }
+
+    void BenchmarkInterreduction() {
+        using Order = GradedReverseLexicographicalOrder;
+
+        std::vector<PolynomialSet<Rational<>, Order>> family;
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            family.push_back(RandomSystem<Rational<>, Order>(seed, 4, 4, 2, 3, 10));
+        }
+        auto katsura = Katsura3<WordPrimeField, LexicographicalOrder>();
+
+        std::cout << "Final interreduction\n";
+        for (bool isParallel : {false, true}) {
+            BuchbergerOptions options;
+            options.parallelInterreduction = isParallel;
+
+            double rational = MeasureSeconds([&] {
+                for (const auto &set : family) {
+                    auto basis = set;
+                    BuhbergerAlgorithm(basis, options);
+                }
+            });
+            double modular = MeasureSeconds([&] {
+                auto basis = katsura;
+                BuhbergerAlgorithm(basis, options);
+            });
+
+            std::cout << "  " << (isParallel ? "parallel" : "sequential") << ": 20 random 4x4 over Q "
+                      << rational * 1e3 << " ms; katsura-3 mod p, lex " << modular * 1e3 << " ms\n";
+        }
+    }
+
+    void BenchmarkConcurrentBasis() {
+        using Order = GradedReverseLexicographicalOrder;
+
+        auto cyclic = Cyclic<WordPrimeField, Order>(4);
+        auto katsura = Katsura3<WordPrimeField, LexicographicalOrder>();
+
+        std::cout << "Concurrent basis\n";
+        for (size_t amountOfThreads : {0u, 1u, 2u, 4u}) {
+            BuchbergerOptions options;
+            options.useConcurrentBasis = amountOfThreads != 0;
+            options.amountOfThreads = amountOfThreads;
+
+            double cyclicTime = MeasureSeconds([&] {
+                auto basis = cyclic;
+                BuhbergerAlgorithm(basis, options);
+            });
+            double katsuraTime = MeasureSeconds([&] {
+                auto basis = katsura;
+                BuhbergerAlgorithm(basis, options);
+            });
+
+            std::cout << "  ";
+            if (amountOfThreads == 0) {
+                std::cout << "sequential";
+            } else {
+                std::cout << amountOfThreads << " threads";
+            }
+            std::cout << ": cyclic-4 mod p " << cyclicTime * 1e3 << " ms; katsura-3 mod p, lex "
+                      << katsuraTime * 1e3 << " ms\n";
+        }
+    }
+
+    void BenchmarkTermStreams() {
+        using Order = GradedReverseLexicographicalOrder;
+
+        std::vector<PolynomialSet<Rational<>, Order>> family;
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            auto basis = RandomSystem<Rational<>, Order>(seed, 4, 4, 2, 3, 10);
+            BuhbergerAlgorithm(basis);
+            family.push_back(std::move(basis));
+        }
+        auto cyclic = Cyclic<WordPrimeField, Order>(4);
+        BuhbergerAlgorithm(cyclic);
+
+        // Every S-pair of a basis reduces to zero, only the reduction itself is measured.
+        auto reduceAll = [] (const auto &basis, bool isStreamed) {
+            for (const auto &first : basis) {
+                for (const auto &second : basis) {
+                    if (first == second) {
+                        break;
+                    }
+                    auto remainder = isStreamed ? HeapReduction(SPolynomialStream(first, second), basis) :
+                                                  HeapReduction(SPolynomial(first, second), basis);
+                    assert(remainder == std::decay_t<decltype(remainder)>(0));
+                }
+            }
+        };
+
+        std::cout << "S-pair reduction of a basis\n";
+        for (bool isStreamed : {false, true}) {
+            double rational = MeasureSeconds([&] {
+                for (const auto &basis : family) {
+                    reduceAll(basis, isStreamed);
+                }
+            }, 10);
+            double modular = MeasureSeconds([&] {
+                reduceAll(cyclic, isStreamed);
+            }, 10);
+
+            std::cout << "  " << (isStreamed ? "streamed" : "materialized") << ": 20 random 4x4 over Q "
+                      << rational * 1e3 << " ms; cyclic-4 mod p " << modular * 1e3 << " ms\n";
+        }
+    }
+
+    // Binomials x^a - x^b with random exponents up to maxDegree in every variable.
+    template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+    PolynomialSet<FieldType, MonomialOrder> RandomBinomials(uint64_t seed, size_t amountOfVariables,
+                                                            size_t amountOfGenerators, uint64_t maxDegree)
+    {
+        using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+        std::mt19937_64 generator(seed);
+        std::uniform_int_distribution<uint64_t> degree(0, maxDegree);
+
+        auto randomMonomial = [&] {
+            Monomial::DegreeVector degrees(amountOfVariables);
+            for (auto &value : degrees) {
+                value = degree(generator);
+            }
+            return Monomial(std::move(degrees));
+        };
+
+        PolynomialSet<FieldType, MonomialOrder> result;
+        while (result.size() < amountOfGenerators) {
+            auto binomial = PolynomialType(randomMonomial()) - PolynomialType(randomMonomial());
+            if (!PolynomialType::IsZero(binomial)) {
+                result.insert(std::move(binomial));
+            }
+        }
+        return result;
+    }
+
+    void BenchmarkBinomialEngine() {
+        using Order = GradedReverseLexicographicalOrder;
+
+        std::vector<PolynomialSet<Rational<>, Order>> family;
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            family.push_back(RandomBinomials<Rational<>, Order>(seed, 5, 4, 2));
+        }
+
+        std::cout << "Binomial ideals\n";
+        for (bool isBinomialEngine : {false, true}) {
+            BuchbergerOptions options;
+            options.useBinomialEngine = isBinomialEngine;
+            double seconds = MeasureSeconds([&] {
+                for (const auto &set : family) {
+                    auto basis = set;
+                    BuhbergerAlgorithm(basis, options);
+                }
+            });
+
+            std::cout << "  " << (isBinomialEngine ? "binomial engine" : "Buchberger") << ": 20 random 5x4 over Q "
+                      << seconds * 1e3 << " ms\n";
+        }
+    }
+
+    void BenchmarkDenseArithmetic() {
+        using Order = GradedReverseLexicographicalOrder;
+
+        std::vector<PolynomialSet<WordPrimeField, Order>> bivariate, trivariate;
+        for (uint64_t seed = 1; seed <= 5; ++seed) {
+            bivariate.push_back(RandomSystem<WordPrimeField, Order>(seed, 2, 2, 5, 12, 10));
+            trivariate.push_back(RandomSystem<WordPrimeField, Order>(seed, 3, 3, 2, 8, 10));
+        }
+
+        std::cout << "Dense arithmetic\n";
+        for (bool isDense : {false, true}) {
+            BuchbergerOptions options;
+            options.useDenseArithmetic = isDense;
+            auto measure = [&] (const auto &family) {
+                return MeasureSeconds([&] {
+                    for (const auto &set : family) {
+                        auto basis = set;
+                        BuhbergerAlgorithm(basis, options);
+                    }
+                });
+            };
+            double bivariateTime = measure(bivariate);
+            double trivariateTime = measure(trivariate);
+
+            std::cout << "  " << (isDense ? "dense" : "sparse") << ": 5 random 2x2 of degree 5 mod p "
+                      << bivariateTime * 1e3 << " ms; 5 random 3x3 of degree 2 mod p " << trivariateTime * 1e3
+                      << " ms\n";
+        }
+
+        auto factor = *bivariate.front().begin();
+        double sparse = MeasureSeconds([&] {
+            auto product = factor * factor * factor;
+        }, 100);
+        double dense = MeasureSeconds([&] {
+            DensePolynomial<WordPrimeField, Order> denseFactor(factor);
+            auto product = (denseFactor * denseFactor * denseFactor).ToPolynomial();
+        }, 100);
+        std::cout << "  cube of a bivariate polynomial of degree 5: sparse " << sparse * 1e6 << " us, dense "
+                  << dense * 1e6 << " us\n";
+    }
+
+} // namespace
+
+    void RunBenchmarks() {
+        BenchmarkPrimeFields();
+        BenchmarkStrategies();
+        BenchmarkReducerSelection();
+        BenchmarkMultipleCache();
+        BenchmarkInterreduction();
+        BenchmarkConcurrentBasis();
+        BenchmarkTermStreams();
+        BenchmarkBinomialEngine();
+        BenchmarkDenseArithmetic();
+    }
+
+} // namespace GB
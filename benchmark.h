@@ -0,0 +1,7 @@
+#pragma once
+
+namespace GB {
+
+    void RunBenchmarks();
+
+} // namespace GB
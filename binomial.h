@@ -0,0 +1,334 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "monomial.h"
+#include "order.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GB {
+
+// Monomial in a fixed amount of variables with the exponents packed into 16-bit fields of
+// 64-bit words, variable 0 in the highest field of the first word. The top bit of every field
+// is kept clear as a guard, so multiplication, division and the divisibility test work on
+// whole words without carries between fields, and comparing the words as unsigned numbers
+// compares the exponent vectors lexicographically.
+class PackedMonomial {
+public:
+    using IndexType = size_t;
+
+    static constexpr IndexType kFieldsPerWord = 4;
+    static constexpr IndexType kFieldBits = 16;
+    static constexpr uint64_t kMaxDegree = 0x7fff;
+    static constexpr uint64_t kGuardBits = 0x8000800080008000ull;
+
+    PackedMonomial() = default;
+
+    PackedMonomial(const Monomial &monomial, IndexType amountOfVariables)
+        : words_((amountOfVariables + kFieldsPerWord - 1) / kFieldsPerWord)
+    {
+        for (IndexType index = 0; index < monomial.GetAmountOfVariables(); ++index) {
+            auto degree = static_cast<uint64_t>(monomial.GetDegree(index));
+            if (degree > kMaxDegree) {
+                throw std::overflow_error("Degree does not fit into a packed monomial");
+            }
+            words_[index / kFieldsPerWord] |= degree << Shift_(index);
+            totalDegree_ += degree;
+        }
+    }
+
+    [[nodiscard]] Monomial ToMonomial() const {
+        Monomial::DegreeVector degrees(words_.size() * kFieldsPerWord);
+        for (IndexType index = 0; index < degrees.size(); ++index) {
+            degrees[index] = GetDegree(index);
+        }
+        return Monomial(std::move(degrees));
+    }
+
+    [[nodiscard]] uint64_t GetDegree(IndexType index) const noexcept {
+        return (words_[index / kFieldsPerWord] >> Shift_(index)) & kMaxDegree;
+    }
+
+    [[nodiscard]] uint64_t TotalDegree() const noexcept {
+        return totalDegree_;
+    }
+
+    [[nodiscard]] bool IsDivisibleBy(const PackedMonomial &other) const noexcept {
+        for (IndexType word = 0; word < words_.size(); ++word) {
+            if ((((words_[word] | kGuardBits) - other.words_[word]) & kGuardBits) != kGuardBits) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend PackedMonomial operator*(const PackedMonomial &lhs, const PackedMonomial &rhs) {
+        PackedMonomial result = lhs;
+        for (IndexType word = 0; word < result.words_.size(); ++word) {
+            result.words_[word] += rhs.words_[word];
+            if ((result.words_[word] & kGuardBits) != 0) {
+                throw std::overflow_error("Degree does not fit into a packed monomial");
+            }
+        }
+        result.totalDegree_ += rhs.totalDegree_;
+        return result;
+    }
+
+    // The divisor must divide the monomial.
+    friend PackedMonomial operator/(const PackedMonomial &lhs, const PackedMonomial &rhs) noexcept {
+        PackedMonomial result = lhs;
+        for (IndexType word = 0; word < result.words_.size(); ++word) {
+            result.words_[word] -= rhs.words_[word];
+        }
+        result.totalDegree_ -= rhs.totalDegree_;
+        return result;
+    }
+
+    // Fields where the first exponent is not smaller keep their guard bit after the subtraction,
+    // spreading it over the field gives the mask choosing the first exponent.
+    friend PackedMonomial Lcm(const PackedMonomial &lhs, const PackedMonomial &rhs) noexcept {
+        PackedMonomial result = lhs;
+        result.totalDegree_ = 0;
+        for (IndexType word = 0; word < result.words_.size(); ++word) {
+            uint64_t isNotSmaller = ((lhs.words_[word] | kGuardBits) - rhs.words_[word]) & kGuardBits;
+            uint64_t mask = (isNotSmaller >> (kFieldBits - 1)) * 0xffff;
+            result.words_[word] = (lhs.words_[word] & mask) | (rhs.words_[word] & ~mask);
+        }
+        for (IndexType index = 0; index < result.words_.size() * kFieldsPerWord; ++index) {
+            result.totalDegree_ += result.GetDegree(index);
+        }
+        return result;
+    }
+
+    friend bool operator==(const PackedMonomial &lhs, const PackedMonomial &rhs) noexcept {
+        return lhs.words_ == rhs.words_;
+    }
+
+    friend bool operator!=(const PackedMonomial &lhs, const PackedMonomial &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    // Lexicographical comparison of the exponent vectors, the one of LexicographicalOrder.
+    [[nodiscard]] static bool IsLexLess(const PackedMonomial &lhs, const PackedMonomial &rhs) noexcept {
+        return lhs.words_ < rhs.words_;
+    }
+
+private:
+    static IndexType Shift_(IndexType index) noexcept {
+        return (kFieldsPerWord - 1 - index % kFieldsPerWord) * kFieldBits;
+    }
+
+    std::vector<uint64_t> words_;
+    uint64_t totalDegree_ = 0;
+};
+
+// The orders of order.h on packed monomials, other orders go through Monomial.
+template<SuitableOrder<Monomial> MonomialOrder>
+struct PackedOrder {
+    bool operator()(const PackedMonomial &lhs, const PackedMonomial &rhs) const {
+        if constexpr (std::is_same_v<MonomialOrder, LexicographicalOrder>) {
+            return PackedMonomial::IsLexLess(lhs, rhs);
+        } else if constexpr (std::is_same_v<MonomialOrder, ReverseLexicographicalOrder>) {
+            return PackedMonomial::IsLexLess(rhs, lhs);
+        } else if constexpr (std::is_same_v<MonomialOrder, GradedLexicographicalOrder>) {
+            return lhs.TotalDegree() != rhs.TotalDegree() ? lhs.TotalDegree() < rhs.TotalDegree() :
+                                                            PackedMonomial::IsLexLess(lhs, rhs);
+        } else if constexpr (std::is_same_v<MonomialOrder, GradedReverseLexicographicalOrder>) {
+            return lhs.TotalDegree() != rhs.TotalDegree() ? lhs.TotalDegree() < rhs.TotalDegree() :
+                                                            PackedMonomial::IsLexLess(rhs, lhs);
+        } else {
+            return MonomialOrder()(lhs.ToMonomial(), rhs.ToMonomial());
+        }
+    }
+};
+
+// Element leading - coefficient * trailing of a binomial ideal, a monomial when the coefficient is zero.
+template<SuitableFieldType FieldType>
+struct Binomial {
+    PackedMonomial leading;
+    PackedMonomial trailing;
+    FieldType coefficient;
+};
+
+// Whether every generator has at most two terms.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+bool IsBinomialSet(const PolynomialSet<FieldType, MonomialOrder> &set) {
+    return std::all_of(set.begin(), set.end(), [] (const Polynomial<FieldType, MonomialOrder> &polynomial) {
+        return polynomial.GetAmountOfTerms() <= 2;
+    });
+}
+
+// Buchberger algorithm for ideals generated by binomials, with the same result as BuhbergerAlgorithm.
+// The S-polynomial of two binomials is a combination of their trailing terms and the reduction
+// of a term by a binomial replaces it by one term, so every intermediate polynomial has at most
+// two terms and the normal form of a binomial is the sum of the normal forms of its terms.
+// Pairs are taken by smallest lcm and skipped by the product criterion and Buchberger's chain
+// criterion: (i, j) is dropped when some LM(g_k) divides its lcm and (i, k), (j, k) are done.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+void BinomialBuhbergerAlgorithm(PolynomialSet<FieldType, MonomialOrder> &set) {
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using BinomialType = Binomial<FieldType>;
+    using Term = std::pair<PackedMonomial, FieldType>;
+    using IndexType = size_t;
+
+    if (!IsBinomialSet(set)) {
+        throw std::invalid_argument("Generators are not binomials");
+    }
+
+    IndexType amountOfVariables = 0;
+    for (const auto &polynomial : set) {
+        for (const auto &[monomial, coefficient] : polynomial) {
+            amountOfVariables = std::max(amountOfVariables, monomial.GetAmountOfVariables());
+        }
+    }
+
+    PackedOrder<MonomialOrder> order;
+    std::vector<BinomialType> basis;
+
+    auto reduceTerm = [&] (Term term, const std::vector<BinomialType> &reducers) -> std::optional<Term> {
+        while (true) {
+            auto reducer = std::find_if(reducers.begin(), reducers.end(), [&] (const BinomialType &binomial) {
+                return term.first.IsDivisibleBy(binomial.leading);
+            });
+            if (reducer == reducers.end()) {
+                return term;
+            }
+            if (reducer->coefficient == FieldType(0)) {
+                return std::nullopt;
+            }
+            term = {term.first / reducer->leading * reducer->trailing, term.second * reducer->coefficient};
+        }
+    };
+
+    // Makes the sum of two terms monic, std::nullopt when it is zero.
+    auto makeBinomial = [&] (std::optional<Term> first, std::optional<Term> second) -> std::optional<BinomialType> {
+        if (first.has_value() && second.has_value() && first->first == second->first) {
+            first->second += second->second;
+            second.reset();
+        }
+        if (first.has_value() && first->second == FieldType(0)) {
+            first.reset();
+        }
+        if (!first.has_value()) {
+            std::swap(first, second);
+        }
+        if (!first.has_value()) {
+            return std::nullopt;
+        }
+        if (!second.has_value()) {
+            return BinomialType{first->first, first->first, FieldType(0)};
+        }
+        if (order(first->first, second->first)) {
+            std::swap(first, second);
+        }
+        return BinomialType{first->first, second->first, -(second->second / first->second)};
+    };
+
+    auto normalForm = [&] (std::optional<Term> first, std::optional<Term> second) {
+        return makeBinomial(first.has_value() ? reduceTerm(*first, basis) : std::nullopt,
+                            second.has_value() ? reduceTerm(*second, basis) : std::nullopt);
+    };
+
+    struct Pair {
+        PackedMonomial lcm;
+        IndexType first;
+        IndexType second;
+    };
+    auto isLaterPair = [&] (const Pair &lhs, const Pair &rhs) {
+        return order(rhs.lcm, lhs.lcm);
+    };
+    std::priority_queue<Pair, std::vector<Pair>, decltype(isLaterPair)> pairs(isLaterPair);
+    // isPending[j][i] for i < j tells that the pair (i, j) is still queued.
+    std::vector<std::vector<bool>> isPending;
+
+    auto addToBasis = [&] (BinomialType binomial) {
+        isPending.emplace_back(basis.size(), true);
+        for (IndexType index = 0; index < basis.size(); ++index) {
+            pairs.push(Pair{Lcm(basis[index].leading, binomial.leading), index, basis.size()});
+        }
+        basis.push_back(std::move(binomial));
+    };
+    auto isDone = [&] (IndexType first, IndexType second) {
+        return first < second ? !isPending[second][first] : !isPending[first][second];
+    };
+
+    for (const auto &polynomial : set) {
+        std::optional<Term> terms[2];
+        IndexType position = 0;
+        for (const auto &[monomial, coefficient] : polynomial) {
+            terms[position++] = Term{PackedMonomial(monomial, amountOfVariables), coefficient};
+        }
+        if (auto reduced = normalForm(terms[0], terms[1]); reduced.has_value()) {
+            addToBasis(std::move(*reduced));
+        }
+    }
+
+    while (!pairs.empty()) {
+        auto [lcm, firstIndex, secondIndex] = pairs.top();
+        pairs.pop();
+        isPending[secondIndex][firstIndex] = false;
+
+        const auto first = basis[firstIndex];
+        const auto second = basis[secondIndex];
+        if (lcm.TotalDegree() == first.leading.TotalDegree() + second.leading.TotalDegree()) {
+            continue;
+        }
+        bool isChained = false;
+        for (IndexType index = 0; index < basis.size() && !isChained; ++index) {
+            isChained = index != firstIndex && index != secondIndex && lcm.IsDivisibleBy(basis[index].leading) &&
+                        isDone(index, firstIndex) && isDone(index, secondIndex);
+        }
+        if (isChained) {
+            continue;
+        }
+
+        // (lcm / L_1) g_1 - (lcm / L_2) g_2 = c_2 (lcm / L_2) T_2 - c_1 (lcm / L_1) T_1.
+        auto tail = [&] (const BinomialType &binomial, bool isNegated) -> std::optional<Term> {
+            if (binomial.coefficient == FieldType(0)) {
+                return std::nullopt;
+            }
+            return Term{lcm / binomial.leading * binomial.trailing,
+                        isNegated ? -binomial.coefficient : binomial.coefficient};
+        };
+        if (auto reduced = normalForm(tail(first, true), tail(second, false)); reduced.has_value()) {
+            addToBasis(std::move(*reduced));
+        }
+    }
+
+    std::vector<BinomialType> minimal;
+    for (IndexType index = 0; index < basis.size(); ++index) {
+        bool isRedundant = false;
+        for (IndexType other = 0; other < basis.size() && !isRedundant; ++other) {
+            isRedundant = other != index && basis[index].leading.IsDivisibleBy(basis[other].leading) &&
+                          (basis[index].leading != basis[other].leading || other < index);
+        }
+        if (!isRedundant) {
+            minimal.push_back(basis[index]);
+        }
+    }
+
+    // The trailing term is smaller than the leading one, so no element reduces its own tail.
+    PolynomialSet<FieldType, MonomialOrder> result;
+    for (const auto &binomial : minimal) {
+        PolynomialType polynomial(binomial.leading.ToMonomial());
+        if (binomial.coefficient != FieldType(0)) {
+            if (auto tail = reduceTerm(Term{binomial.trailing, -binomial.coefficient}, minimal); tail.has_value()) {
+                polynomial += PolynomialType(typename PolynomialType::Term{tail->first.ToMonomial(), tail->second});
+            }
+        }
+        result.insert(std::move(polynomial));
+    }
+
+    set = std::move(result);
+}
+
+} // namespace GB
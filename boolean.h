@@ -0,0 +1,458 @@
+#pragma once
+
+#include "concepts.h"
+#include "monomial.h"
+#include "polynomial.h"
+#include "gf2.h"
+
+#include <cstdint>
+
+#include <bit>
+#include <iostream>
+#include <queue>
+#include <set>
+#include <vector>
+
+namespace GB {
+
+// Monomial of the boolean ring F_2[x_0, ..., x_n] / (x_i^2 - x_i): every variable appears
+// at most once, so the monomial is the set of its variables stored as a bitset.
+// Multiplication is the union of the sets and divisibility is inclusion.
+class BooleanMonomial {
+public:
+    using IndexType = Monomial::IndexType;
+    using DegreeType = uint64_t;
+
+    static constexpr IndexType kWordSize = 64;
+
+    BooleanMonomial() = default;
+
+    // Lists the indices of the variables, e.g. {0, 2} is x_0 * x_2.
+    BooleanMonomial(std::initializer_list<IndexType> variables) {
+        for (auto variable : variables) {
+            Set_(variable);
+        }
+    }
+
+    // Applies the field equations: every variable of positive degree appears once.
+    explicit BooleanMonomial(const Monomial &monomial) {
+        for (IndexType variableIndex = 0; variableIndex < monomial.GetAmountOfVariables(); ++variableIndex) {
+            if (monomial.GetDegree(variableIndex) != 0) {
+                Set_(variableIndex);
+            }
+        }
+    }
+
+    [[nodiscard]] IndexType GetAmountOfVariables() const noexcept {
+        return words_.empty() ? 0 : (words_.size() - 1) * kWordSize + std::bit_width(words_.back());
+    }
+
+    [[nodiscard]] bool HasVariable(IndexType variableIndex) const noexcept {
+        return variableIndex / kWordSize < words_.size() && (words_[variableIndex / kWordSize] >> (variableIndex % kWordSize)) & 1;
+    }
+
+    [[nodiscard]] DegreeType TotalDegree() const noexcept {
+        DegreeType result = 0;
+        for (auto word : words_) {
+            result += std::popcount(word);
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] Monomial ToMonomial() const {
+        Monomial::DegreeVector degrees(GetAmountOfVariables());
+        for (IndexType variableIndex = 0; variableIndex < degrees.size(); ++variableIndex) {
+            degrees[variableIndex] = HasVariable(variableIndex) ? 1 : 0;
+        }
+
+        return Monomial(std::move(degrees));
+    }
+
+    BooleanMonomial &operator*=(const BooleanMonomial &other) {
+        words_.resize(std::max(words_.size(), other.words_.size()));
+        for (IndexType word = 0; word < other.words_.size(); ++word) {
+            words_[word] |= other.words_[word];
+        }
+
+        return *this;
+    }
+
+    [[nodiscard]] bool IsDivisibleBy(const BooleanMonomial &other) const noexcept {
+        if (other.words_.size() > words_.size()) {
+            return false;
+        }
+        for (IndexType word = 0; word < other.words_.size(); ++word) {
+            if ((other.words_[word] & ~words_[word]) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    BooleanMonomial &operator/=(const BooleanMonomial &other) {
+        if (!IsDivisibleBy(other)) {
+            throw std::runtime_error("Monomial cannot be divided by another");
+        }
+        for (IndexType word = 0; word < other.words_.size(); ++word) {
+            words_[word] &= ~other.words_[word];
+        }
+
+        Shrink_();
+        return *this;
+    }
+
+    friend BooleanMonomial operator*(const BooleanMonomial &lhs, const BooleanMonomial &rhs) {
+        BooleanMonomial result = lhs;
+        result *= rhs;
+
+        return result;
+    }
+
+    friend BooleanMonomial operator/(const BooleanMonomial &lhs, const BooleanMonomial &rhs) {
+        BooleanMonomial result = lhs;
+        result /= rhs;
+
+        return result;
+    }
+
+    // Lexicographical comparison of the exponent vectors, x_0 being the most significant,
+    // the same as the comparison of Monomial. The first variable present in exactly one of
+    // the monomials decides.
+    friend bool operator<(const BooleanMonomial &lhs, const BooleanMonomial &rhs) noexcept {
+        for (IndexType word = 0; word < std::max(lhs.words_.size(), rhs.words_.size()); ++word) {
+            uint64_t lhsWord = word < lhs.words_.size() ? lhs.words_[word] : 0;
+            uint64_t rhsWord = word < rhs.words_.size() ? rhs.words_[word] : 0;
+            if (uint64_t difference = lhsWord ^ rhsWord; difference != 0) {
+                return (rhsWord >> std::countr_zero(difference)) & 1;
+            }
+        }
+
+        return false;
+    }
+
+    friend bool operator==(const BooleanMonomial &lhs, const BooleanMonomial &rhs) noexcept {
+        return lhs.words_ == rhs.words_;
+    }
+
+    friend bool operator!=(const BooleanMonomial &lhs, const BooleanMonomial &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const BooleanMonomial &other) {
+        out << other.ToMonomial();
+        return out;
+    }
+
+private:
+    void Set_(IndexType variableIndex) {
+        if (words_.size() <= variableIndex / kWordSize) {
+            words_.resize(variableIndex / kWordSize + 1);
+        }
+        words_[variableIndex / kWordSize] |= uint64_t(1) << (variableIndex % kWordSize);
+    }
+
+    void Shrink_() {
+        while (!words_.empty() && words_.back() == 0) {
+            words_.pop_back();
+        }
+    }
+
+    std::vector<uint64_t> words_;
+};
+
+inline BooleanMonomial Lcm(const BooleanMonomial &first, const BooleanMonomial &second) {
+    return first * second;
+}
+
+struct BooleanLexicographicalOrder {
+    bool operator()(const BooleanMonomial &lhs, const BooleanMonomial &rhs) const {
+        return lhs < rhs;
+    }
+};
+
+struct BooleanGradedLexicographicalOrder {
+    bool operator()(const BooleanMonomial &lhs, const BooleanMonomial &rhs) const {
+        auto lTotalDegree = lhs.TotalDegree();
+        auto rTotalDegree = rhs.TotalDegree();
+
+        if (lTotalDegree == rTotalDegree) {
+            return lhs < rhs;
+        }
+
+        return lTotalDegree < rTotalDegree;
+    }
+};
+
+// Element of the boolean ring. Coefficients are implicit (the ring is over GF(2)), so the
+// polynomial is the set of its monomials and addition is the symmetric difference.
+template<SuitableOrder<BooleanMonomial> MonomialOrder = BooleanLexicographicalOrder>
+class BooleanPolynomial {
+public:
+    using MonomialSet = std::set<BooleanMonomial, MonomialOrder>;
+    using IndexType = BooleanMonomial::IndexType;
+
+    BooleanPolynomial() = default;
+
+    BooleanPolynomial(std::initializer_list<BooleanMonomial> monomials) {
+        for (const auto &monomial : monomials) {
+            AddMonomial_(monomial);
+        }
+    }
+
+    BooleanPolynomial(BooleanMonomial monomial) : monomials_{std::move(monomial)} {
+    }
+
+    // Reduces the polynomial modulo the field equations.
+    template<SuitableOrder<Monomial> OtherMonomialOrder>
+    explicit BooleanPolynomial(const Polynomial<GF2, OtherMonomialOrder> &polynomial) {
+        for (const auto &[monomial, coefficient] : polynomial) {
+            AddMonomial_(BooleanMonomial(monomial));
+        }
+    }
+
+    template<SuitableOrder<Monomial> OtherMonomialOrder>
+    [[nodiscard]] Polynomial<GF2, OtherMonomialOrder> ToPolynomial() const {
+        Polynomial<GF2, OtherMonomialOrder> result;
+        for (const auto &monomial : monomials_) {
+            result += Polynomial<GF2, OtherMonomialOrder>(monomial.ToMonomial());
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] IndexType GetAmountOfTerms() const noexcept {
+        return monomials_.size();
+    }
+
+    [[nodiscard]] const BooleanMonomial &GetLeadingMonomial() const {
+        return *monomials_.rbegin();
+    }
+
+    [[nodiscard]] bool Contains(const BooleanMonomial &monomial) const {
+        return monomials_.contains(monomial);
+    }
+
+    BooleanPolynomial &operator+=(const BooleanPolynomial &other) {
+        for (const auto &monomial : other.monomials_) {
+            AddMonomial_(monomial);
+        }
+
+        return *this;
+    }
+
+    BooleanPolynomial &operator-=(const BooleanPolynomial &other) {
+        return *this += other;
+    }
+
+    friend BooleanPolynomial operator+(const BooleanPolynomial &lhs, const BooleanPolynomial &rhs) {
+        BooleanPolynomial result = lhs;
+        result += rhs;
+
+        return result;
+    }
+
+    friend BooleanPolynomial operator-(const BooleanPolynomial &lhs, const BooleanPolynomial &rhs) {
+        return lhs + rhs;
+    }
+
+    BooleanPolynomial &operator*=(const BooleanPolynomial &other) {
+        *this = *this * other;
+        return *this;
+    }
+
+    friend BooleanPolynomial operator*(const BooleanPolynomial &lhs, const BooleanPolynomial &rhs) {
+        BooleanPolynomial result;
+        for (const auto &leftMonomial : lhs.monomials_) {
+            for (const auto &rightMonomial : rhs.monomials_) {
+                result.AddMonomial_(leftMonomial * rightMonomial);
+            }
+        }
+
+        return result;
+    }
+
+    // Monomials in decreasing order, like the terms of Polynomial.
+    typename MonomialSet::const_reverse_iterator begin() const noexcept {
+        return monomials_.crbegin();
+    }
+
+    typename MonomialSet::const_reverse_iterator end() const noexcept {
+        return monomials_.crend();
+    }
+
+    friend bool operator==(const BooleanPolynomial &lhs, const BooleanPolynomial &rhs) {
+        return lhs.monomials_ == rhs.monomials_;
+    }
+
+    friend bool operator!=(const BooleanPolynomial &lhs, const BooleanPolynomial &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const BooleanPolynomial &lhs, const BooleanPolynomial &rhs) {
+        return std::lexicographical_compare(lhs.monomials_.begin(), lhs.monomials_.end(),
+                                            rhs.monomials_.begin(), rhs.monomials_.end());
+    }
+
+    static bool IsZero(const BooleanPolynomial &other) {
+        return other.monomials_.empty();
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const BooleanPolynomial &other) {
+        if (IsZero(other)) {
+            out << "0";
+            return out;
+        }
+
+        for (auto iter = other.begin(); iter != other.end(); ++iter) {
+            if (iter != other.begin()) {
+                out << " + ";
+            }
+            if (iter->GetAmountOfVariables() == 0) {
+                out << "1";
+            } else {
+                out << *iter;
+            }
+        }
+
+        return out;
+    }
+
+private:
+    void AddMonomial_(const BooleanMonomial &monomial) {
+        if (auto [iter, isInserted] = monomials_.insert(monomial); !isInserted) {
+            monomials_.erase(iter);
+        }
+    }
+
+    MonomialSet monomials_;
+};
+
+template<SuitableOrder<BooleanMonomial> MonomialOrder = BooleanLexicographicalOrder>
+using BooleanPolynomialSet = std::set<BooleanPolynomial<MonomialOrder>>;
+
+template<SuitableOrder<BooleanMonomial> MonomialOrder>
+BooleanPolynomial<MonomialOrder> BooleanNormalForm(
+        BooleanPolynomial<MonomialOrder> reducible,
+        const std::vector<BooleanPolynomial<MonomialOrder>> &basis)
+{
+    BooleanPolynomial<MonomialOrder> remainder;
+
+    while (!BooleanPolynomial<MonomialOrder>::IsZero(reducible)) {
+        const auto leading = reducible.GetLeadingMonomial();
+
+        auto reducer = std::find_if(basis.begin(), basis.end(), [&] (const auto &polynomial) {
+            return !BooleanPolynomial<MonomialOrder>::IsZero(polynomial) &&
+                   leading.IsDivisibleBy(polynomial.GetLeadingMonomial());
+        });
+
+        if (reducer == basis.end()) {
+            remainder += leading;
+            reducible += leading;
+        } else {
+            reducible += BooleanPolynomial<MonomialOrder>(leading / reducer->GetLeadingMonomial()) * *reducer;
+        }
+    }
+
+    return remainder;
+}
+
+// Buchberger algorithm in the boolean ring. The field equations x_i^2 - x_i are never stored:
+// all arithmetic is already done modulo them, and their S-pairs with an element f reduce
+// to the products x_i * f for the variables x_i of the leading monomial of f, which are
+// queued together with the ordinary pairs. The result equals the reduced Gröbner basis of
+// the ideal plus the field equations, with the field equations themselves left out.
+template<SuitableOrder<BooleanMonomial> MonomialOrder>
+void BuhbergerAlgorithm(BooleanPolynomialSet<MonomialOrder> &set) {
+    using PolynomialType = BooleanPolynomial<MonomialOrder>;
+    using IndexType = size_t;
+
+    static constexpr IndexType kFieldEquation = static_cast<IndexType>(-1);
+
+    // The second element is a basis index, or kFieldEquation for the product by variable.
+    struct Pair {
+        BooleanMonomial lcm;
+        IndexType first;
+        IndexType second;
+        IndexType variable;
+    };
+    auto isLaterPair = [] (const Pair &lhs, const Pair &rhs) {
+        return MonomialOrder()(rhs.lcm, lhs.lcm);
+    };
+    std::priority_queue<Pair, std::vector<Pair>, decltype(isLaterPair)> pairs(isLaterPair);
+
+    std::vector<PolynomialType> basis;
+    auto addToBasis = [&] (PolynomialType polynomial) {
+        const auto &leading = polynomial.GetLeadingMonomial();
+        for (IndexType index = 0; index < basis.size(); ++index) {
+            if (!PolynomialType::IsZero(basis[index])) {
+                pairs.push(Pair{Lcm(basis[index].GetLeadingMonomial(), leading), index, basis.size(), 0});
+            }
+        }
+        for (IndexType variable = 0; variable < leading.GetAmountOfVariables(); ++variable) {
+            if (leading.HasVariable(variable)) {
+                pairs.push(Pair{leading, basis.size(), kFieldEquation, variable});
+            }
+        }
+        basis.push_back(std::move(polynomial));
+    };
+
+    for (const auto &generator : set) {
+        auto reduced = BooleanNormalForm(generator, basis);
+        if (!PolynomialType::IsZero(reduced)) {
+            addToBasis(std::move(reduced));
+        }
+    }
+
+    while (!pairs.empty()) {
+        auto pair = pairs.top();
+        pairs.pop();
+
+        PolynomialType sPolynomial;
+        if (pair.second == kFieldEquation) {
+            sPolynomial = PolynomialType(BooleanMonomial{pair.variable}) * basis[pair.first];
+        } else {
+            const auto &first = basis[pair.first];
+            const auto &second = basis[pair.second];
+            if ((first.GetLeadingMonomial().TotalDegree() + second.GetLeadingMonomial().TotalDegree()) ==
+                pair.lcm.TotalDegree()) {
+                continue;
+            }
+            sPolynomial = PolynomialType(pair.lcm / first.GetLeadingMonomial()) * first +
+                          PolynomialType(pair.lcm / second.GetLeadingMonomial()) * second;
+        }
+
+        auto reduced = BooleanNormalForm(std::move(sPolynomial), basis);
+        if (!PolynomialType::IsZero(reduced)) {
+            addToBasis(std::move(reduced));
+        }
+    }
+
+    std::vector<PolynomialType> minimal;
+    for (IndexType index = 0; index < basis.size(); ++index) {
+        const auto &leading = basis[index].GetLeadingMonomial();
+        bool isRedundant = false;
+        for (IndexType other = 0; other < basis.size() && !isRedundant; ++other) {
+            const auto &otherLeading = basis[other].GetLeadingMonomial();
+            isRedundant = other != index && leading.IsDivisibleBy(otherLeading) &&
+                          (leading != otherLeading || other < index);
+        }
+        if (!isRedundant) {
+            minimal.push_back(basis[index]);
+        }
+    }
+
+    BooleanPolynomialSet<MonomialOrder> result;
+    for (IndexType index = 0; index < minimal.size(); ++index) {
+        auto others = minimal;
+        others.erase(others.begin() + index);
+
+        const auto &leading = minimal[index].GetLeadingMonomial();
+        result.insert(BooleanNormalForm(minimal[index] + leading, others) + leading);
+    }
+
+    set = std::move(result);
+}
+
+} // namespace GB
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "binomial.h"
+#include "concurrent.h"
+#include "decomposition.h"
+#include "elimination.h"
+#include "lifting.h"
+#include "options.h"
+#include "prefilter.h"
+#include "modular.h"
+#include "multiples.h"
+#include "normalization.h"
+#include "rational.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace GB {
+
+// Buchberger's algorithm with the optional passes of BuchbergerOptions.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+void BuhbergerAlgorithm(PolynomialSet<FieldType, MonomialOrder> &set, const BuchbergerOptions &options) {
+    if (options.saturateMonomialFactors) {
+        Monomial::DegreeVector variables;
+        for (const auto &polynomial : set) {
+            if (Polynomial<FieldType, MonomialOrder>::IsZero(polynomial)) {
+                continue;
+            }
+            auto content = GetMonomialContent(polynomial);
+            variables.resize(std::max(variables.size(), content.GetAmountOfVariables()));
+            for (Monomial::IndexType index = 0; index < content.GetAmountOfVariables(); ++index) {
+                if (content.GetDegree(index) != 0) {
+                    variables[index] = 1;
+                }
+            }
+        }
+
+        Monomial product(std::move(variables));
+        if (!Monomial::HasNoVariables(product)) {
+            set = Saturate(set, product);
+            return;
+        }
+    }
+
+    if (options.normalizeGenerators) {
+        auto content = NormalizeGenerators(set);
+        auto normalizedOptions = options;
+        normalizedOptions.normalizeGenerators = false;
+        normalizedOptions.saturateMonomialFactors = false;
+        BuhbergerAlgorithm(set, normalizedOptions);
+
+        if (!Monomial::HasNoVariables(content)) {
+            PolynomialSet<FieldType, MonomialOrder> multipliedSet;
+            for (const auto &polynomial : set) {
+                multipliedSet.insert(polynomial * content);
+            }
+            set = std::move(multipliedSet);
+        }
+        return;
+    }
+
+    if (options.useBinomialEngine && IsBinomialSet(set)) {
+        BinomialBuhbergerAlgorithm(set);
+        return;
+    }
+
+    if (options.eliminateLinearEquations) {
+        LinearElimination<FieldType, MonomialOrder> elimination(set);
+        auto remaining = elimination.GetRemainingPart();
+
+        if (!elimination.IsInconsistent() && !remaining.empty()) {
+            auto remainingOptions = options;
+            remainingOptions.eliminateLinearEquations = false;
+            BuhbergerAlgorithm(remaining, remainingOptions);
+        }
+
+        set = elimination.MapBack(std::move(remaining));
+        return;
+    }
+
+    if (options.decomposeComponents) {
+        auto components = SplitIntoComponents(set);
+        auto componentOptions = options;
+        componentOptions.decomposeComponents = false;
+        // Every component counts its reductions on its own, the sum is added at the end.
+        std::vector<ReductionStatistics> componentStatistics(components.size());
+
+        std::atomic<size_t> nextComponent = 0;
+        std::exception_ptr exception;
+        std::mutex exceptionMutex;
+        [[maybe_unused]] uint32_t modulus = 0;
+        if constexpr (std::is_same_v<FieldType, RuntimeModular>) {
+            modulus = RuntimeModular::GetCurrentModulus();
+        }
+
+        auto work = [&] {
+            try {
+                // The modulus of RuntimeModular is thread-local, the workers inherit the caller's one.
+                std::optional<RuntimeModular::ModulusScope> scope;
+                if constexpr (std::is_same_v<FieldType, RuntimeModular>) {
+                    scope.emplace(modulus);
+                }
+
+                for (size_t index = nextComponent++; index < components.size(); index = nextComponent++) {
+                    auto localOptions = componentOptions;
+                    localOptions.statistics = options.statistics != nullptr ? &componentStatistics[index] : nullptr;
+                    BuhbergerAlgorithm(components[index], localOptions);
+                }
+            } catch (...) {
+                std::lock_guard lock(exceptionMutex);
+                exception = std::current_exception();
+            }
+        };
+
+        size_t amountOfThreads = options.amountOfThreads != 0 ? options.amountOfThreads :
+                                 std::max(1u, std::thread::hardware_concurrency());
+        amountOfThreads = std::max<size_t>(1, std::min(amountOfThreads, components.size()));
+
+        std::vector<std::thread> threads;
+        for (size_t thread = 1; thread < amountOfThreads; ++thread) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        if (options.statistics != nullptr) {
+            for (const auto &statistics : componentStatistics) {
+                *options.statistics += statistics;
+            }
+        }
+
+        // Leading monomials of different components are coprime and tails share no variables,
+        // so the union stays reduced unless some component is the whole ring.
+        set.clear();
+        for (auto &component : components) {
+            if (component.size() == 1 && Monomial::HasNoVariables(component.begin()->GetLeadingTerm().first)) {
+                set = std::move(component);
+                return;
+            }
+            set.merge(component);
+        }
+        return;
+    }
+
+    if constexpr (std::is_same_v<FieldType, Rational<>>) {
+        if (options.usePAdicLifting) {
+            PAdicBuhbergerAlgorithm(set);
+            return;
+        }
+        if (options.useModularPreFilter) {
+            PreFilteredBuhbergerAlgorithm(set, options);
+            return;
+        }
+    }
+
+    ReducerPolicy policy{options.reducerSelection, options.statistics, options.useDenseArithmetic};
+    if (options.useConcurrentBasis) {
+        ConcurrentBuhbergerAlgorithm(set, options.amountOfThreads, policy);
+        return;
+    }
+
+    size_t interreductionThreads = options.parallelInterreduction ? options.amountOfThreads : 1;
+    if (options.multipleCacheTerms != 0) {
+        MonomialMultipleCache<FieldType, MonomialOrder> cache(options.multipleCacheTerms, options.simplifyMultiples);
+        BuhbergerAlgorithm(set, cache, policy, interreductionThreads);
+        if (options.multipleCacheStatistics != nullptr) {
+            *options.multipleCacheStatistics = cache.GetStatistics();
+        }
+        return;
+    }
+
+    BuhbergerAlgorithm(set, policy, interreductionThreads);
+}
+
+} // namespace GB
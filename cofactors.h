@@ -0,0 +1,277 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "division.h"
+#include "algorithms.h"
+
+#include <map>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace GB {
+
+// Remembers how every polynomial met during a Gröbner basis computation was obtained.
+// Each element is stored together with one step: a combination of earlier elements
+// (the S-polynomial multipliers and the division quotients). Cofactors with respect
+// to the input generators are expanded only when they are asked for, so tracking
+// costs one quotient list per reduction instead of one cofactor vector per element.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+class CofactorTracker {
+public:
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using IndexType = size_t;
+    // element = sum multiplier * element[index], every index refers to an earlier element.
+    using Combination = std::vector<std::pair<IndexType, PolynomialType>>;
+
+    IndexType AddGenerator(PolynomialType generator) {
+        if (elements_.size() != generatorCount_) {
+            throw std::logic_error("Generators have to be added before derived elements");
+        }
+
+        ++generatorCount_;
+        return AddElement_(std::move(generator), {});
+    }
+
+    IndexType AddDerived(PolynomialType element, Combination combination) {
+        for (auto &[index, multiplier] : combination) {
+            if (index >= elements_.size()) {
+                throw std::out_of_range("Combination refers to an unknown element");
+            }
+        }
+
+        return AddElement_(std::move(element), std::move(combination));
+    }
+
+    [[nodiscard]] IndexType GetAmountOfGenerators() const noexcept {
+        return generatorCount_;
+    }
+
+    [[nodiscard]] IndexType GetAmountOfElements() const noexcept {
+        return elements_.size();
+    }
+
+    [[nodiscard]] const PolynomialType &GetElement(IndexType index) const {
+        return elements_.at(index).polynomial;
+    }
+
+    // The latest element equal to the polynomial, e.g. a member of the computed basis.
+    [[nodiscard]] std::optional<IndexType> FindElement(const PolynomialType &polynomial) const {
+        if (auto found = indexByPolynomial_.find(polynomial); found != indexByPolynomial_.end()) {
+            return found->second;
+        }
+
+        return std::nullopt;
+    }
+
+    // Returns h such that element = sum h[i] * generator[i].
+    std::vector<PolynomialType> GetCofactors(IndexType index) {
+        if (index >= elements_.size()) {
+            throw std::out_of_range("Unknown element");
+        }
+
+        // Collect the elements the requested one depends on, then expand them bottom-up.
+        std::vector<IndexType> stack = {index};
+        std::vector<bool> isNeeded(elements_.size());
+        isNeeded[index] = true;
+        while (!stack.empty()) {
+            IndexType current = stack.back();
+            stack.pop_back();
+            if (cofactors_[current].has_value()) {
+                continue;
+            }
+            for (const auto &[dependency, multiplier] : elements_[current].combination) {
+                if (!isNeeded[dependency]) {
+                    isNeeded[dependency] = true;
+                    stack.push_back(dependency);
+                }
+            }
+        }
+
+        for (IndexType current = 0; current <= index; ++current) {
+            if (isNeeded[current] && !cofactors_[current].has_value()) {
+                cofactors_[current] = Expand_(current);
+            }
+        }
+
+        return *cofactors_[index];
+    }
+
+    std::vector<PolynomialType> GetCofactors(const PolynomialType &polynomial) {
+        auto index = FindElement(polynomial);
+        if (!index.has_value()) {
+            throw std::out_of_range("Polynomial is not tracked");
+        }
+
+        return GetCofactors(*index);
+    }
+
+private:
+    struct Element_ {
+        PolynomialType polynomial;
+        Combination combination;
+    };
+
+    IndexType AddElement_(PolynomialType polynomial, Combination combination) {
+        IndexType index = elements_.size();
+
+        indexByPolynomial_[polynomial] = index;
+        elements_.push_back(Element_{std::move(polynomial), std::move(combination)});
+        cofactors_.emplace_back();
+
+        return index;
+    }
+
+    std::vector<PolynomialType> Expand_(IndexType index) const {
+        std::vector<PolynomialType> result(generatorCount_);
+        if (index < generatorCount_) {
+            result[index] = PolynomialType(FieldType(1));
+            return result;
+        }
+
+        for (const auto &[dependency, multiplier] : elements_[index].combination) {
+            const auto &dependencyCofactors = *cofactors_[dependency];
+            for (IndexType generator = 0; generator < generatorCount_; ++generator) {
+                if (!PolynomialType::IsZero(dependencyCofactors[generator])) {
+                    result[generator] += multiplier * dependencyCofactors[generator];
+                }
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<Element_> elements_;
+    std::vector<std::optional<std::vector<PolynomialType>>> cofactors_;
+    std::map<PolynomialType, IndexType, Less<FieldType>> indexByPolynomial_;
+    IndexType generatorCount_ = 0;
+};
+
+// Buchberger algorithm that records every step in the tracker. Pairs are processed one by one
+// against a growing basis (interreduction would rewrite elements and lose the steps),
+// then the basis is minimized, tail-reduced and normalized; these last steps are recorded too,
+// so the result equals the one of BuhbergerAlgorithm(set) and every element has cofactors.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+void BuhbergerAlgorithm(PolynomialSet<FieldType, MonomialOrder> &set, CofactorTracker<FieldType, MonomialOrder> &tracker) {
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using IndexType = typename CofactorTracker<FieldType, MonomialOrder>::IndexType;
+    using Combination = typename CofactorTracker<FieldType, MonomialOrder>::Combination;
+
+    std::vector<IndexType> basis;
+    std::vector<PolynomialType> basisPolynomials;
+    // Normal strategy: the pair with the smallest lcm of leading monomials goes first,
+    // which keeps both the degrees of new elements and the recorded quotients small.
+    struct Pair {
+        Monomial lcm;
+        IndexType first;
+        IndexType second;
+    };
+    auto isLaterPair = [] (const Pair &lhs, const Pair &rhs) {
+        return MonomialOrder()(rhs.lcm, lhs.lcm);
+    };
+    std::priority_queue<Pair, std::vector<Pair>, decltype(isLaterPair)> pairs(isLaterPair);
+
+    auto addToBasis = [&] (IndexType index) {
+        for (IndexType position = 0; position < basis.size(); ++position) {
+            pairs.push(Pair{Lcm(basisPolynomials[position].GetLeadingTerm().first,
+                                tracker.GetElement(index).GetLeadingTerm().first), position, basis.size()});
+        }
+        basis.push_back(index);
+        basisPolynomials.push_back(tracker.GetElement(index));
+    };
+
+    auto addReduced = [&] (const PolynomialType &reducible, Combination combination) {
+        auto [quotients, remainder] = Divide(reducible, basisPolynomials);
+        if (PolynomialType::IsZero(remainder)) {
+            return;
+        }
+
+        for (IndexType position = 0; position < quotients.size(); ++position) {
+            if (!PolynomialType::IsZero(quotients[position])) {
+                combination.emplace_back(basis[position], -quotients[position]);
+            }
+        }
+        addToBasis(tracker.AddDerived(std::move(remainder), std::move(combination)));
+    };
+
+    std::vector<IndexType> generators;
+    for (const auto &generator : set) {
+        generators.push_back(tracker.AddGenerator(generator));
+    }
+    for (auto index : generators) {
+        PolynomialType generator = tracker.GetElement(index);
+        if (!PolynomialType::IsZero(generator)) {
+            addReduced(generator, {{index, PolynomialType(FieldType(1))}});
+        }
+    }
+
+    while (!pairs.empty()) {
+        auto [pairLcm, firstPosition, secondPosition] = pairs.top();
+        pairs.pop();
+
+        const auto &first = basisPolynomials[firstPosition];
+        const auto &second = basisPolynomials[secondPosition];
+        if (CheckLeadingTermsCoprime(first, second)) {
+            continue;
+        }
+
+        const auto &l1 = first.GetLeadingTerm();
+        const auto &l2 = second.GetLeadingTerm();
+        const auto termsLCM = Lcm(l1.first, l2.first);
+
+        PolynomialType firstMultiplier(typename PolynomialType::Term{termsLCM / l1.first, l2.second});
+        PolynomialType secondMultiplier(typename PolynomialType::Term{termsLCM / l2.first, -l1.second});
+
+        addReduced(firstMultiplier * first + secondMultiplier * second, {
+            {basis[firstPosition], firstMultiplier},
+            {basis[secondPosition], secondMultiplier}
+        });
+    }
+
+    std::vector<IndexType> minimal;
+    for (IndexType position = 0; position < basis.size(); ++position) {
+        const auto &leading = basisPolynomials[position].GetLeadingTerm().first;
+        bool isRedundant = false;
+        for (IndexType other = 0; other < basis.size() && !isRedundant; ++other) {
+            const auto &otherLeading = basisPolynomials[other].GetLeadingTerm().first;
+            isRedundant = other != position && leading.IsDivisibleBy(otherLeading) &&
+                          (leading != otherLeading || other < position);
+        }
+        if (!isRedundant) {
+            minimal.push_back(position);
+        }
+    }
+
+    PolynomialSet<FieldType, MonomialOrder> result;
+    for (auto position : minimal) {
+        std::vector<PolynomialType> others;
+        std::vector<IndexType> otherIndices;
+        for (auto other : minimal) {
+            if (other != position) {
+                others.push_back(basisPolynomials[other]);
+                otherIndices.push_back(basis[other]);
+            }
+        }
+
+        auto [quotients, remainder] = Divide(basisPolynomials[position], others);
+        PolynomialType normalization(FieldType(1) / remainder.GetLeadingTerm().second);
+
+        Combination combination = {{basis[position], normalization}};
+        for (IndexType other = 0; other < quotients.size(); ++other) {
+            if (!PolynomialType::IsZero(quotients[other])) {
+                combination.emplace_back(otherIndices[other], -quotients[other] * normalization);
+            }
+        }
+
+        auto reduced = remainder * normalization;
+        tracker.AddDerived(reduced, std::move(combination));
+        result.insert(std::move(reduced));
+    }
+
+    set = std::move(result);
+}
+
+} // namespace GB
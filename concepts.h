@@ -2,6 +2,7 @@
 
 #include <type_traits>
 #include <functional>
+#include <cstdint>
 
 namespace GB {
 
@@ -31,6 +32,14 @@ concept SuitableFieldType = Arithmetic<T> && requires(T value) {
     { value == value } -> IsSame<bool>;
 };
 
+// Fields Z/pZ expose their modulus and the canonical representative of an element,
+// which lets algorithms work on machine words instead of going through the field operators.
+template<typename T>
+concept PrimeFieldType = SuitableFieldType<T> && requires(T value) {
+    { T::GetModulus() } -> ConvertibleTo<uint64_t>;
+    { value.GetValue() } -> ConvertibleTo<uint64_t>;
+};
+
 template<typename T, typename U>
 concept SuitableOrder = requires(T value, U lhs, U rhs) {
     { value.operator ()(lhs, rhs) } -> IsSame<bool>;
@@ -0,0 +1,348 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "division.h"
+#include "interreduction.h"
+#include "modular.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GB {
+
+// Append-only basis shared by reducing threads. Readers never lock: elements live in
+// chunks of doubling size which never move, a slot is filled before the published size
+// is raised past it, so a reader sees a consistent prefix of the basis. Leading monomials
+// are stored next to the elements and form the reducer index, an element may only be
+// replaced by one with the same leading monomial, so the index never changes. Replaced
+// elements are reclaimed by epochs: a reader pins the global epoch while it holds a
+// ReadGuard, and an element retired at epoch e is deleted once every pinned epoch is past e.
+// Appending and replacing are serialized among the writers only.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+class ConcurrentBasis {
+public:
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using IndexType = size_t;
+
+    // At most this many guards are held at once, further readers wait for a free record.
+    static constexpr size_t kMaxReaders = 64;
+
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const ConcurrentBasis &basis) : basis_(&basis), record_(basis.Pin_()) {
+        }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+
+        ~ReadGuard() {
+            basis_->Unpin_(record_);
+        }
+
+    private:
+        const ConcurrentBasis *basis_;
+        size_t record_;
+    };
+
+    ConcurrentBasis() = default;
+
+    ConcurrentBasis(const ConcurrentBasis &) = delete;
+    ConcurrentBasis &operator=(const ConcurrentBasis &) = delete;
+
+    ~ConcurrentBasis() {
+        for (size_t chunk = 0; chunk < kMaxChunks; ++chunk) {
+            if (auto *slots = chunks_[chunk].load(std::memory_order_relaxed); slots != nullptr) {
+                for (size_t offset = 0; offset < ChunkSize_(chunk); ++offset) {
+                    delete slots[offset].polynomial.load(std::memory_order_relaxed);
+                }
+                delete[] slots;
+            }
+        }
+        for (auto &[polynomial, epoch] : retired_) {
+            delete polynomial;
+        }
+    }
+
+    // Amount of published elements, all of them may be read.
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // The element must be published, the reference is valid while the guard lives.
+    [[nodiscard]] const PolynomialType &Get(IndexType index, const ReadGuard &) const noexcept {
+        return *GetSlot_(index).polynomial.load(std::memory_order_seq_cst);
+    }
+
+    [[nodiscard]] const Monomial &GetLeadingMonomial(IndexType index) const noexcept {
+        return GetSlot_(index).leadingMonomial;
+    }
+
+    // Copies of the first size elements, they share the terms and stay valid without a guard.
+    [[nodiscard]] std::vector<PolynomialType> Snapshot(size_t size) const {
+        ReadGuard guard(*this);
+        std::vector<PolynomialType> result;
+        result.reserve(size);
+        for (IndexType index = 0; index < size; ++index) {
+            result.push_back(Get(index, guard));
+        }
+        return result;
+    }
+
+    // First of the first size elements whose leading monomial divides the monomial, size if none.
+    [[nodiscard]] IndexType FindReducer(const Monomial &monomial, size_t size) const noexcept {
+        for (IndexType index = 0; index < size; ++index) {
+            if (monomial.IsDivisibleBy(GetLeadingMonomial(index))) {
+                return index;
+            }
+        }
+        return size;
+    }
+
+    // Publishes a non-zero polynomial and returns its index.
+    IndexType Append(PolynomialType polynomial) {
+        std::lock_guard lock(writerMutex_);
+        IndexType index = size_.load(std::memory_order_relaxed);
+        size_t chunk = ChunkIndex_(index);
+        if (chunk >= kMaxChunks) {
+            throw std::length_error("ConcurrentBasis is full");
+        }
+        if (chunks_[chunk].load(std::memory_order_relaxed) == nullptr) {
+            chunks_[chunk].store(new Slot_[ChunkSize_(chunk)], std::memory_order_release);
+        }
+
+        auto &slot = GetSlot_(index);
+        slot.leadingMonomial = polynomial.GetLeadingTerm().first;
+        slot.polynomial.store(new PolynomialType(std::move(polynomial)), std::memory_order_relaxed);
+        size_.store(index + 1, std::memory_order_release);
+        return index;
+    }
+
+    // Replaces a published element by one with the same leading monomial, e.g. its tail-reduced form.
+    void Replace(IndexType index, PolynomialType polynomial) {
+        std::lock_guard lock(writerMutex_);
+        auto &slot = GetSlot_(index);
+        if (polynomial.GetLeadingTerm().first != slot.leadingMonomial) {
+            throw std::invalid_argument("Replacement changes the leading monomial");
+        }
+
+        const PolynomialType *old = slot.polynomial.exchange(new PolynomialType(std::move(polynomial)));
+        // Readers that may still hold the old element pinned an epoch not later than this one.
+        retired_.emplace_back(old, epoch_.fetch_add(1));
+        Reclaim_();
+    }
+
+    // Amount of replaced elements still waiting for readers.
+    [[nodiscard]] size_t GetRetiredCount() const {
+        std::lock_guard lock(writerMutex_);
+        return retired_.size();
+    }
+
+private:
+    struct Slot_ {
+        std::atomic<const PolynomialType *> polynomial = nullptr;
+        Monomial leadingMonomial;
+    };
+
+    static constexpr size_t kFirstChunkLog = 6;
+    static constexpr size_t kMaxChunks = 40;
+    // Epoch 0 marks a free reader record, so the counter starts at 1.
+    static constexpr uint64_t kFree = 0;
+
+    static constexpr size_t ChunkSize_(size_t chunk) noexcept {
+        return size_t(1) << (chunk + kFirstChunkLog);
+    }
+
+    // Chunk k holds the indices from 2^(k + 6) - 2^6 on.
+    static size_t ChunkIndex_(IndexType index) noexcept {
+        return std::bit_width(index + ChunkSize_(0)) - 1 - kFirstChunkLog;
+    }
+
+    Slot_ &GetSlot_(IndexType index) const noexcept {
+        size_t chunk = ChunkIndex_(index);
+        return chunks_[chunk].load(std::memory_order_acquire)[index + ChunkSize_(0) - ChunkSize_(chunk)];
+    }
+
+    size_t Pin_() const {
+        while (true) {
+            for (size_t record = 0; record < kMaxReaders; ++record) {
+                uint64_t expected = kFree;
+                if (readers_[record].compare_exchange_strong(expected, epoch_.load())) {
+                    return record;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void Unpin_(size_t record) const noexcept {
+        readers_[record].store(kFree);
+    }
+
+    // Deletes the retired elements no pinned reader can see, the writer mutex is held.
+    void Reclaim_() {
+        uint64_t oldestPinned = std::numeric_limits<uint64_t>::max();
+        for (const auto &reader : readers_) {
+            if (uint64_t epoch = reader.load(); epoch != kFree) {
+                oldestPinned = std::min(oldestPinned, epoch);
+            }
+        }
+        std::erase_if(retired_, [&] (const std::pair<const PolynomialType *, uint64_t> &element) {
+            if (element.second < oldestPinned) {
+                delete element.first;
+                return true;
+            }
+            return false;
+        });
+    }
+
+    mutable std::array<std::atomic<Slot_ *>, kMaxChunks> chunks_ = {};
+    std::atomic<size_t> size_ = 0;
+    mutable std::atomic<uint64_t> epoch_ = 1;
+    mutable std::array<std::atomic<uint64_t>, kMaxReaders> readers_ = {};
+    mutable std::mutex writerMutex_;
+    std::vector<std::pair<const PolynomialType *, uint64_t>> retired_;
+};
+
+// Buchberger algorithm with S-pairs reduced by several threads at once. Every worker takes
+// a pair, reduces its S-polynomial by the prefix of the ConcurrentBasis published at that
+// moment and appends a non-zero remainder, which creates the pairs with all earlier elements.
+// Since the basis only grows, a remainder computed from a shorter prefix is still a valid
+// element. The set is a Gröbner basis when no pair is left, then it is interreduced.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+void ConcurrentBuhbergerAlgorithm(
+        PolynomialSet<FieldType, MonomialOrder> &set,
+        size_t amountOfThreads = 0,
+        const ReducerPolicy &policy = {})
+{
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using IndexType = size_t;
+
+    ConcurrentBasis<FieldType, MonomialOrder> basis;
+    std::deque<std::pair<IndexType, IndexType>> pairs;
+    std::mutex pairsMutex;
+    std::condition_variable pairsChanged;
+    size_t amountOfBusyWorkers = 0;
+    bool isStopped = false;
+
+    for (const auto &polynomial : set) {
+        if (!PolynomialType::IsZero(polynomial)) {
+            auto added = basis.Append(polynomial);
+            for (IndexType index = 0; index < added; ++index) {
+                pairs.emplace_back(index, added);
+            }
+        }
+    }
+
+    std::exception_ptr exception;
+    std::vector<ReductionStatistics> workerStatistics;
+    [[maybe_unused]] uint32_t modulus = 0;
+    if constexpr (std::is_same_v<FieldType, RuntimeModular>) {
+        modulus = RuntimeModular::GetCurrentModulus();
+    }
+
+    if (amountOfThreads == 0) {
+        amountOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workerStatistics.resize(amountOfThreads);
+
+    auto work = [&] (size_t worker) {
+        try {
+            // The modulus of RuntimeModular is thread-local, the workers inherit the caller's one.
+            std::optional<RuntimeModular::ModulusScope> scope;
+            if constexpr (std::is_same_v<FieldType, RuntimeModular>) {
+                scope.emplace(modulus);
+            }
+
+            while (true) {
+                std::pair<IndexType, IndexType> pair;
+                {
+                    std::unique_lock lock(pairsMutex);
+                    pairsChanged.wait(lock, [&] {
+                        return isStopped || !pairs.empty() || amountOfBusyWorkers == 0;
+                    });
+                    if (isStopped || pairs.empty()) {
+                        pairsChanged.notify_all();
+                        return;
+                    }
+                    pair = pairs.front();
+                    pairs.pop_front();
+                    ++amountOfBusyWorkers;
+                }
+
+                std::optional<PolynomialType> remainder;
+                const auto &[first, second] = pair;
+                if (basis.GetLeadingMonomial(first) * basis.GetLeadingMonomial(second) !=
+                        Lcm(basis.GetLeadingMonomial(first), basis.GetLeadingMonomial(second))) {
+                    auto divisors = basis.Snapshot(basis.GetSize());
+                    auto *statistics = policy.statistics != nullptr ? &workerStatistics[worker] : nullptr;
+                    auto reduced = policy.isDense ?
+                            DenseReduction(SPolynomial(divisors[first], divisors[second]), divisors, nullptr, statistics) :
+                            HeapReduction(SPolynomialStream(divisors[first], divisors[second]), divisors,
+                                          nullptr, policy.selection, statistics);
+                    if (!PolynomialType::IsZero(reduced)) {
+                        remainder = std::move(reduced);
+                    }
+                }
+
+                std::lock_guard lock(pairsMutex);
+                if (remainder.has_value()) {
+                    auto added = basis.Append(std::move(*remainder));
+                    for (IndexType index = 0; index < added; ++index) {
+                        pairs.emplace_back(index, added);
+                    }
+                }
+                --amountOfBusyWorkers;
+                pairsChanged.notify_all();
+            }
+        } catch (...) {
+            std::lock_guard lock(pairsMutex);
+            if (!exception) {
+                exception = std::current_exception();
+            }
+            isStopped = true;
+            pairsChanged.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 1; thread < amountOfThreads; ++thread) {
+        threads.emplace_back(work, thread);
+    }
+    work(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+    if (policy.statistics != nullptr) {
+        for (const auto &statistics : workerStatistics) {
+            *policy.statistics += statistics;
+        }
+    }
+
+    auto elements = basis.Snapshot(basis.GetSize());
+    set = PolynomialSet<FieldType, MonomialOrder>(elements.begin(), elements.end());
+    ParallelInterreduction(set, amountOfThreads);
+}
+
+} // namespace GB
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <vector>
+
+namespace GB {
+
+// Connected components of the graph where generators sharing a variable are adjacent.
+// Ideals of components live in disjoint polynomial rings, the union of their reduced
+// Gröbner bases is the reduced Gröbner basis of the whole ideal. Zero polynomials are
+// dropped, every constant forms a component of its own.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+std::vector<PolynomialSet<FieldType, MonomialOrder>> SplitIntoComponents(
+        const PolynomialSet<FieldType, MonomialOrder> &set)
+{
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using IndexType = Monomial::IndexType;
+
+    IndexType amountOfVariables = 0;
+    for (const auto &polynomial : set) {
+        for (const auto &[monomial, coefficient] : polynomial) {
+            amountOfVariables = std::max(amountOfVariables, monomial.GetAmountOfVariables());
+        }
+    }
+
+    std::vector<IndexType> parents(amountOfVariables);
+    std::iota(parents.begin(), parents.end(), 0);
+    auto find = [&] (IndexType variable) {
+        while (parents[variable] != variable) {
+            variable = parents[variable] = parents[parents[variable]];
+        }
+        return variable;
+    };
+
+    // Constants have no variable to hang on, they get the index past the last variable.
+    auto representative = [&] (const PolynomialType &polynomial) {
+        for (const auto &[monomial, coefficient] : polynomial) {
+            for (IndexType variable = 0; variable < monomial.GetAmountOfVariables(); ++variable) {
+                if (monomial.GetDegree(variable) != 0) {
+                    return variable;
+                }
+            }
+        }
+        return amountOfVariables;
+    };
+
+    for (const auto &polynomial : set) {
+        if (auto first = representative(polynomial); first != amountOfVariables) {
+            for (const auto &[monomial, coefficient] : polynomial) {
+                for (IndexType variable = 0; variable < monomial.GetAmountOfVariables(); ++variable) {
+                    if (monomial.GetDegree(variable) != 0) {
+                        parents[find(variable)] = find(first);
+                    }
+                }
+            }
+        }
+    }
+
+    std::map<IndexType, PolynomialSet<FieldType, MonomialOrder>> components;
+    std::vector<PolynomialSet<FieldType, MonomialOrder>> result;
+    for (const auto &polynomial : set) {
+        if (PolynomialType::IsZero(polynomial)) {
+            continue;
+        }
+        if (auto first = representative(polynomial); first != amountOfVariables) {
+            components[find(first)].insert(polynomial);
+        } else {
+            result.push_back({polynomial});
+        }
+    }
+
+    for (auto &[root, component] : components) {
+        result.push_back(std::move(component));
+    }
+
+    return result;
+}
+
+} // namespace GB
@@ -0,0 +1,395 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "division.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace GB {
+
+// Box of exponents [0, extents[0]) x ... x [0, extents[n - 1]) of dense polynomials, the
+// index of a monomial is its exponent vector read as a mixed-radix number with variable 0
+// as the lowest digit, so the index of a product is the sum of the indices while it stays
+// in the box. The monomials of the box are sorted by the order once per box and thread,
+// layouts are shared through a thread-local cache.
+template<SuitableOrder<Monomial> MonomialOrder>
+class DenseLayout {
+public:
+    using IndexType = size_t;
+    using Extents = std::vector<uint32_t>;
+
+    // Larger boxes are not built, reductions leaving them fall back to the sparse division.
+    static constexpr size_t kMaxSize = size_t(1) << 20;
+
+    static std::shared_ptr<const DenseLayout> Get(const Extents &extents) {
+        thread_local std::map<Extents, std::shared_ptr<const DenseLayout>> cache;
+        auto &layout = cache[extents];
+        if (!layout) {
+            layout = std::shared_ptr<const DenseLayout>(new DenseLayout(extents));
+        }
+        return layout;
+    }
+
+    static size_t GetSize(const Extents &extents) {
+        return std::accumulate(extents.begin(), extents.end(), size_t(1), [] (size_t size, uint32_t extent) {
+            return size > kMaxSize ? size : size * extent;
+        });
+    }
+
+    [[nodiscard]] const Extents &GetExtents() const noexcept {
+        return extents_;
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return monomials_.size();
+    }
+
+    [[nodiscard]] size_t GetAmountOfVariables() const noexcept {
+        return extents_.size();
+    }
+
+    [[nodiscard]] IndexType GetStride(size_t variable) const noexcept {
+        return strides_[variable];
+    }
+
+    [[nodiscard]] const Monomial &GetMonomial(IndexType index) const noexcept {
+        return monomials_[index];
+    }
+
+    [[nodiscard]] uint32_t GetDegree(IndexType index, size_t variable) const noexcept {
+        return static_cast<uint32_t>(index / strides_[variable] % extents_[variable]);
+    }
+
+    // Indices of the box from the largest monomial down.
+    [[nodiscard]] const std::vector<IndexType> &GetDescending() const noexcept {
+        return descending_;
+    }
+
+    // Position of an index in GetDescending().
+    [[nodiscard]] size_t GetPosition(IndexType index) const noexcept {
+        return positions_[index];
+    }
+
+    [[nodiscard]] bool Contains(const Monomial &monomial) const noexcept {
+        for (size_t variable = 0; variable < monomial.GetAmountOfVariables(); ++variable) {
+            if (monomial.GetDegree(variable) != 0 &&
+                (variable >= extents_.size() || monomial.GetDegree(variable) >= extents_[variable])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The monomial must lie in the box.
+    [[nodiscard]] IndexType GetIndex(const Monomial &monomial) const noexcept {
+        IndexType index = 0;
+        for (size_t variable = 0; variable < std::min(monomial.GetAmountOfVariables(), extents_.size()); ++variable) {
+            index += static_cast<IndexType>(monomial.GetDegree(variable)) * strides_[variable];
+        }
+        return index;
+    }
+
+private:
+    explicit DenseLayout(Extents extents) : extents_(std::move(extents)), strides_(extents_.size()) {
+        IndexType size = 1;
+        for (size_t variable = 0; variable < extents_.size(); ++variable) {
+            strides_[variable] = size;
+            size *= extents_[variable];
+        }
+
+        monomials_.reserve(size);
+        for (IndexType index = 0; index < size; ++index) {
+            Monomial::DegreeVector degrees(extents_.size());
+            for (size_t variable = 0; variable < extents_.size(); ++variable) {
+                degrees[variable] = GetDegree(index, variable);
+            }
+            monomials_.emplace_back(std::move(degrees));
+        }
+
+        descending_.resize(size);
+        std::iota(descending_.begin(), descending_.end(), 0);
+        std::sort(descending_.begin(), descending_.end(), [&] (IndexType lhs, IndexType rhs) {
+            return MonomialOrder()(monomials_[rhs], monomials_[lhs]);
+        });
+        positions_.resize(size);
+        for (size_t position = 0; position < size; ++position) {
+            positions_[descending_[position]] = position;
+        }
+    }
+
+    Extents extents_;
+    std::vector<IndexType> strides_;
+    std::vector<Monomial> monomials_;
+    std::vector<IndexType> descending_;
+    std::vector<size_t> positions_;
+};
+
+// Polynomial stored as the array of coefficients of all monomials of a box. Products and
+// reductions become loops over arrays with index arithmetic instead of map operations,
+// which wins when most monomials of the box occur, i.e. for few variables and low degrees.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+class DensePolynomial {
+public:
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using LayoutType = DenseLayout<MonomialOrder>;
+    using IndexType = typename LayoutType::IndexType;
+    using Extents = typename LayoutType::Extents;
+
+    // The smallest box holding the polynomial.
+    explicit DensePolynomial(const PolynomialType &polynomial)
+        : DensePolynomial(polynomial, GetExtents(polynomial))
+    {
+    }
+
+    DensePolynomial(const PolynomialType &polynomial, const Extents &extents)
+        : layout_(LayoutType::Get(extents)), coefficients_(layout_->GetSize(), FieldType(0))
+    {
+        for (const auto &[monomial, coefficient] : polynomial) {
+            if (!layout_->Contains(monomial)) {
+                throw std::invalid_argument("Polynomial does not fit into the box");
+            }
+            coefficients_[layout_->GetIndex(monomial)] = coefficient;
+        }
+    }
+
+    static Extents GetExtents(const PolynomialType &polynomial) {
+        Extents extents;
+        for (const auto &[monomial, coefficient] : polynomial) {
+            extents.resize(std::max(extents.size(), monomial.GetAmountOfVariables()), 1);
+            for (size_t variable = 0; variable < monomial.GetAmountOfVariables(); ++variable) {
+                auto degree = static_cast<uint32_t>(static_cast<uint64_t>(monomial.GetDegree(variable)));
+                extents[variable] = std::max(extents[variable], degree + 1);
+            }
+        }
+        return extents;
+    }
+
+    [[nodiscard]] PolynomialType ToPolynomial() const {
+        PolynomialType result;
+        for (auto index : layout_->GetDescending()) {
+            if (!(coefficients_[index] == FieldType(0))) {
+                result.PushBackTerm(layout_->GetMonomial(index), coefficients_[index]);
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] const LayoutType &GetLayout() const noexcept {
+        return *layout_;
+    }
+
+    [[nodiscard]] const std::vector<FieldType> &GetCoefficients() const noexcept {
+        return coefficients_;
+    }
+
+    [[nodiscard]] std::vector<FieldType> &GetCoefficients() noexcept {
+        return coefficients_;
+    }
+
+    // Schoolbook product in the box of the summed extents, indices of the factors are mapped
+    // into it once per term and then added.
+    friend DensePolynomial operator*(const DensePolynomial &lhs, const DensePolynomial &rhs) {
+        const auto &lhsExtents = lhs.layout_->GetExtents();
+        const auto &rhsExtents = rhs.layout_->GetExtents();
+        Extents extents(std::max(lhsExtents.size(), rhsExtents.size()), 1);
+        for (size_t variable = 0; variable < extents.size(); ++variable) {
+            extents[variable] = (variable < lhsExtents.size() ? lhsExtents[variable] : 1) +
+                                (variable < rhsExtents.size() ? rhsExtents[variable] : 1) - 1;
+        }
+
+        DensePolynomial result(PolynomialType(), extents);
+        auto lhsIndices = result.MapIndices_(lhs);
+        auto rhsIndices = result.MapIndices_(rhs);
+        for (const auto &[lhsIndex, lhsCoefficient] : lhsIndices) {
+            for (const auto &[rhsIndex, rhsCoefficient] : rhsIndices) {
+                result.coefficients_[lhsIndex + rhsIndex] += lhsCoefficient * rhsCoefficient;
+            }
+        }
+        return result;
+    }
+
+private:
+    // Non-zero terms of a polynomial in a box containing its one, with the indices of this box.
+    std::vector<std::pair<IndexType, FieldType>> MapIndices_(const DensePolynomial &other) const {
+        std::vector<std::pair<IndexType, FieldType>> result;
+        for (IndexType index = 0; index < other.coefficients_.size(); ++index) {
+            if (!(other.coefficients_[index] == FieldType(0))) {
+                IndexType mapped = 0;
+                for (size_t variable = 0; variable < other.layout_->GetAmountOfVariables(); ++variable) {
+                    mapped += other.layout_->GetDegree(index, variable) * layout_->GetStride(variable);
+                }
+                result.emplace_back(mapped, other.coefficients_[index]);
+            }
+        }
+        return result;
+    }
+
+    std::shared_ptr<const LayoutType> layout_;
+    std::vector<FieldType> coefficients_;
+};
+
+// Full reduction of the dividend by the divisors in a dense array, the first eligible divisor
+// reduces each term. The array is walked from the largest monomial down and every reduction
+// subtracts q * g with indices shifted by the index of q. The box starts as the one of the
+// dividend, a box is closed under division, so divisors whose leading monomial lies outside
+// it reduce none of its terms. A product leaving the box doubles the extents; once the box
+// would exceed DenseLayout::kMaxSize, the rest goes to HeapReduction.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder, typename DivisorRange>
+Polynomial<FieldType, MonomialOrder> DenseReduction(
+        const Polynomial<FieldType, MonomialOrder> &dividend,
+        const DivisorRange &divisors,
+        size_t *reductionCount = nullptr,
+        ReductionStatistics *statistics = nullptr)
+{
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using LayoutType = DenseLayout<MonomialOrder>;
+    using DenseType = DensePolynomial<FieldType, MonomialOrder>;
+    using Extents = typename DenseType::Extents;
+    using IndexType = typename DenseType::IndexType;
+
+    auto include = [] (Extents &extents, const Monomial &monomial) {
+        extents.resize(std::max(extents.size(), monomial.GetAmountOfVariables()), 1);
+        for (size_t variable = 0; variable < monomial.GetAmountOfVariables(); ++variable) {
+            auto degree = static_cast<uint32_t>(static_cast<uint64_t>(monomial.GetDegree(variable)));
+            while (extents[variable] <= degree) {
+                extents[variable] *= 2;
+            }
+        }
+    };
+
+    std::vector<const PolynomialType *> reducers;
+    Extents extents = DenseType::GetExtents(dividend);
+    for (const auto &divisor : divisors) {
+        if (!PolynomialType::IsZero(divisor)) {
+            reducers.push_back(&divisor);
+        }
+    }
+
+    size_t amountOfReductions = 0;
+    auto finish = [&] (const PolynomialType &partial, bool isReduced) {
+        auto remainder = partial;
+        if (!isReduced) {
+            size_t heapCount = 0;
+            remainder = HeapReduction(partial, divisors, &heapCount);
+            amountOfReductions += heapCount;
+        }
+        if (reductionCount != nullptr) {
+            *reductionCount = amountOfReductions;
+        }
+        if (statistics != nullptr) {
+            statistics->reductions += amountOfReductions;
+        }
+        return remainder;
+    };
+
+    if (PolynomialType::IsZero(dividend) || LayoutType::GetSize(extents) > LayoutType::kMaxSize) {
+        return finish(dividend, PolynomialType::IsZero(dividend));
+    }
+
+    DenseType dense(dividend, extents);
+    // Terms of a reducer with their indices in the current box and its own box, mapped when the
+    // reducer is first used in this box. A monomial of the box is divisible by a leading monomial
+    // when no digit of its index is smaller, and the index of the quotient is then the difference.
+    std::vector<std::vector<std::pair<IndexType, FieldType>>> reducerTerms(reducers.size());
+    std::vector<Extents> reducerExtents(reducers.size());
+    std::vector<IndexType> leadingIndices(reducers.size());
+    constexpr IndexType kOutside = ~IndexType(0);
+    auto mapLeadingMonomials = [&] {
+        for (size_t reducer = 0; reducer < reducers.size(); ++reducer) {
+            reducerTerms[reducer].clear();
+            const auto &leading = reducers[reducer]->GetLeadingTerm().first;
+            leadingIndices[reducer] = dense.GetLayout().Contains(leading) ? dense.GetLayout().GetIndex(leading) :
+                                      kOutside;
+        }
+    };
+    // Only called once the reducer's box shifted by the quotient is known to fit.
+    auto mapReducer = [&] (size_t reducer) {
+        if (reducerTerms[reducer].empty()) {
+            for (const auto &[monomial, coefficient] : *reducers[reducer]) {
+                reducerTerms[reducer].emplace_back(dense.GetLayout().GetIndex(monomial), coefficient);
+            }
+        }
+    };
+    mapLeadingMonomials();
+
+    size_t position = dense.GetLayout().GetPosition(dense.GetLayout().GetIndex(dividend.GetLeadingTerm().first));
+    while (position < dense.GetLayout().GetSize()) {
+        const auto &layout = dense.GetLayout();
+        auto index = layout.GetDescending()[position];
+        const auto coefficient = dense.GetCoefficients()[index];
+        auto divides = [&] (size_t reducer) {
+            auto leadingIndex = leadingIndices[reducer];
+            if (leadingIndex == kOutside) {
+                return false;
+            }
+            for (size_t variable = 0; variable < layout.GetAmountOfVariables(); ++variable) {
+                if (layout.GetDegree(index, variable) < layout.GetDegree(leadingIndex, variable)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        size_t reducerIndex = 0;
+        if (!(coefficient == FieldType(0))) {
+            while (reducerIndex < reducers.size() && !divides(reducerIndex)) {
+                ++reducerIndex;
+            }
+        }
+        if (coefficient == FieldType(0) || reducerIndex == reducers.size()) {
+            ++position;
+            continue;
+        }
+
+        if (reducerExtents[reducerIndex].empty()) {
+            reducerExtents[reducerIndex] = DenseType::GetExtents(*reducers[reducerIndex]);
+        }
+        const auto &leadingTerm = reducers[reducerIndex]->GetLeadingTerm();
+        auto offset = index - leadingIndices[reducerIndex];
+
+        // The tail of the reducer may use variables the box does not have yet.
+        bool fits = true;
+        for (size_t variable = 0; variable < reducerExtents[reducerIndex].size() && fits; ++variable) {
+            fits = variable < layout.GetAmountOfVariables() ?
+                   layout.GetDegree(offset, variable) + reducerExtents[reducerIndex][variable] <=
+                   layout.GetExtents()[variable] :
+                   reducerExtents[reducerIndex][variable] == 1;
+        }
+        if (!fits) {
+            auto target = layout.GetMonomial(index);
+            auto quotient = target / leadingTerm.first;
+            Extents grown = layout.GetExtents();
+            for (const auto &[divisorMonomial, divisorCoefficient] : *reducers[reducerIndex]) {
+                include(grown, divisorMonomial * quotient);
+            }
+            auto partial = dense.ToPolynomial();
+            if (LayoutType::GetSize(grown) > LayoutType::kMaxSize) {
+                return finish(partial, false);
+            }
+            dense = DenseType(partial, grown);
+            mapLeadingMonomials();
+            position = dense.GetLayout().GetPosition(dense.GetLayout().GetIndex(target));
+            continue;
+        }
+
+        mapReducer(reducerIndex);
+        FieldType factor = coefficient / leadingTerm.second;
+        auto &coefficients = dense.GetCoefficients();
+        for (const auto &[termIndex, termCoefficient] : reducerTerms[reducerIndex]) {
+            coefficients[termIndex + offset] -= factor * termCoefficient;
+        }
+        ++amountOfReductions;
+        ++position;
+    }
+
+    return finish(dense.ToPolynomial(), true);
+}
+
+} // namespace GB
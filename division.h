@@ -0,0 +1,359 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "streams.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+namespace GB {
+
+// Which of the divisors whose leading monomial divides a term reduces it.
+enum class ReducerSelection {
+    // The first one in range order.
+    kFirst,
+    // The one with the fewest terms.
+    kShortest,
+    // The one giving the product of the lowest sugar degree, deg(term / LM(g)) + sugar(g),
+    // where the sugar of a divisor is its highest total degree.
+    kLowestSugar,
+    // The one with the smallest coefficients, measured in bits over Q.
+    kSmallestCoefficients,
+    // The last one in range order, for ranges kept in insertion order.
+    kMostRecent
+};
+
+struct ReductionStatistics {
+    size_t reductions = 0;
+    // Reductions where more than one divisor was eligible, kFirst stops at the first one and never counts them.
+    size_t ambiguousReductions = 0;
+    // Reductions where the selection chose another divisor than the first eligible one.
+    size_t redirectedReductions = 0;
+
+    ReductionStatistics &operator+=(const ReductionStatistics &other) noexcept {
+        reductions += other.reductions;
+        ambiguousReductions += other.ambiguousReductions;
+        redirectedReductions += other.redirectedReductions;
+        return *this;
+    }
+};
+
+// Multivariate division in the style of Monagan and Pearce. Instead of subtracting
+// materialized products quotient * divisor from the dividend, all the products
+// q_j * g_k are merged lazily through one priority queue keyed by monomial.
+// For every divisor the heap holds at most one entry per divisor term, so no
+// intermediate polynomial is ever built and the memory is bounded by the size
+// of the divisors plus the output.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+class HeapDivision {
+public:
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using IndexType = size_t;
+
+    template<typename DivisorRange>
+    explicit HeapDivision(const DivisorRange &divisors, ReducerSelection selection = ReducerSelection::kFirst)
+        : selection_(selection)
+    {
+        for (const auto &divisor : divisors) {
+            divisors_.push_back(Divisor_{&divisor, {}, {}, Score_(divisor)});
+        }
+    }
+
+    // Returns the remainder of the dividend, fully reduced with respect to the divisors.
+    // Each term is reduced by the eligible divisor the selection prefers, ties go to range order.
+    PolynomialType Reduce(const PolynomialType &dividend) {
+        return Reduce(PolynomialTermStream<FieldType, MonomialOrder>(dividend));
+    }
+
+    // Same for a dividend read lazily from a stream, each of its terms is read once.
+    template<TermStream Stream>
+    PolynomialType Reduce(Stream dividend) {
+        for (auto &divisor : divisors_) {
+            divisor.quotient.clear();
+            divisor.waitingColumns.clear();
+        }
+        reductionCount_ = 0;
+        statistics_ = {};
+
+        PolynomialType remainder;
+
+        while (!dividend.IsEnd() || !heap_.empty()) {
+            Monomial monomial;
+            FieldType coefficient = 0;
+
+            if (heap_.empty() || (!dividend.IsEnd() && !order_(dividend.GetTerm().first, heap_.top().monomial))) {
+                monomial = dividend.GetTerm().first;
+                coefficient = dividend.GetTerm().second;
+                dividend.Advance();
+            } else {
+                monomial = heap_.top().monomial;
+            }
+
+            while (!heap_.empty() && heap_.top().monomial == monomial) {
+                auto entry = heap_.top();
+                heap_.pop();
+
+                auto &divisor = divisors_[entry.divisorIndex];
+                coefficient -= divisor.quotient[entry.quotientIndex].second * entry.divisorTerm->second;
+                Advance_(entry);
+            }
+
+            if (coefficient == 0) {
+                continue;
+            }
+
+            if (auto divisorIndex = FindReducer_(monomial); divisorIndex < divisors_.size()) {
+                AddQuotientTerm_(divisorIndex, monomial, coefficient);
+            } else {
+                remainder.PushBackTerm(std::move(monomial), std::move(coefficient));
+            }
+        }
+
+        return remainder;
+    }
+
+    // Quotients of the last Reduce call, in the order the divisors were given.
+    [[nodiscard]] std::vector<PolynomialType> GetQuotients() const {
+        std::vector<PolynomialType> quotients;
+        quotients.reserve(divisors_.size());
+
+        for (const auto &divisor : divisors_) {
+            PolynomialType quotient;
+            for (const auto &[monomial, coefficient] : divisor.quotient) {
+                quotient.PushBackTerm(monomial, coefficient);
+            }
+            quotients.push_back(std::move(quotient));
+        }
+
+        return quotients;
+    }
+
+    // Amount of elementary reductions performed by the last Reduce call.
+    [[nodiscard]] size_t GetReductionCount() const noexcept {
+        return reductionCount_;
+    }
+
+    // Reducer choices of the last Reduce call.
+    [[nodiscard]] const ReductionStatistics &GetStatistics() const noexcept {
+        return statistics_;
+    }
+
+private:
+    using DivisorIterator = typename PolynomialType::TermMap::const_reverse_iterator;
+    using QuotientTerm = std::pair<Monomial, FieldType>;
+
+    struct Divisor_ {
+        const PolynomialType *polynomial;
+        std::vector<QuotientTerm> quotient;
+        // Columns whose next product waits for a quotient term that is not known yet.
+        std::vector<DivisorIterator> waitingColumns;
+        // Lower is preferred, the meaning depends on the selection.
+        size_t score;
+    };
+
+    // Stands for the product quotient[quotientIndex] * divisorTerm of one divisor.
+    struct HeapEntry_ {
+        Monomial monomial;
+        IndexType divisorIndex;
+        IndexType quotientIndex;
+        DivisorIterator divisorTerm;
+    };
+
+    struct HeapEntryLess_ {
+        bool operator()(const HeapEntry_ &lhs, const HeapEntry_ &rhs) const {
+            return MonomialOrder()(lhs.monomial, rhs.monomial);
+        }
+    };
+
+    static size_t CoefficientBits_(const FieldType &coefficient) {
+        if constexpr (std::is_same_v<FieldType, Rational<>>) {
+            return std::bit_width(static_cast<uint64_t>(std::abs(coefficient.GetNumerator()))) +
+                   std::bit_width(static_cast<uint64_t>(coefficient.GetDenominator()));
+        } else {
+            return 0;
+        }
+    }
+
+    size_t Score_(const PolynomialType &divisor) const {
+        size_t score = 0;
+        switch (selection_) {
+            case ReducerSelection::kShortest:
+                return std::distance(divisor.begin(), divisor.end());
+            case ReducerSelection::kLowestSugar:
+                for (const auto &[monomial, coefficient] : divisor) {
+                    score = std::max(score, static_cast<size_t>(monomial.TotalDegree()));
+                }
+                return PolynomialType::IsZero(divisor) ? score :
+                       score - static_cast<size_t>(divisor.GetLeadingTerm().first.TotalDegree());
+            case ReducerSelection::kSmallestCoefficients:
+                for (const auto &[monomial, coefficient] : divisor) {
+                    score = std::max(score, CoefficientBits_(coefficient));
+                }
+                return score;
+            default:
+                return 0;
+        }
+    }
+
+    // For the lowest sugar the score holds sugar(g) - deg(LM(g)), the degree of the term is common to all.
+    IndexType FindReducer_(const Monomial &monomial) {
+        IndexType first = divisors_.size(), best = divisors_.size();
+        size_t amountOfEligible = 0;
+
+        for (IndexType divisorIndex = 0; divisorIndex < divisors_.size(); ++divisorIndex) {
+            const auto &divisor = divisors_[divisorIndex];
+            if (PolynomialType::IsZero(*divisor.polynomial) ||
+                !monomial.IsDivisibleBy(divisor.polynomial->GetLeadingTerm().first)) {
+                continue;
+            }
+
+            if (first == divisors_.size()) {
+                first = divisorIndex;
+                if (selection_ == ReducerSelection::kFirst) {
+                    break;
+                }
+            }
+            ++amountOfEligible;
+            if (best == divisors_.size() || selection_ == ReducerSelection::kMostRecent ||
+                divisor.score < divisors_[best].score) {
+                best = divisorIndex;
+            }
+        }
+
+        if (selection_ == ReducerSelection::kFirst) {
+            best = first;
+        }
+        if (best != divisors_.size()) {
+            ++statistics_.reductions;
+            statistics_.ambiguousReductions += amountOfEligible > 1;
+            statistics_.redirectedReductions += best != first;
+        }
+
+        return best;
+    }
+
+    void Push_(IndexType divisorIndex, IndexType quotientIndex, DivisorIterator divisorTerm) {
+        const auto &quotientTerm = divisors_[divisorIndex].quotient[quotientIndex];
+        heap_.push(HeapEntry_{quotientTerm.first * divisorTerm->first, divisorIndex, quotientIndex, divisorTerm});
+    }
+
+    // Products of a column decrease with the quotient index and products of the first
+    // quotient term decrease along the divisor, so each popped entry releases at most
+    // its two successors and both are smaller than the monomial being processed.
+    void Advance_(const HeapEntry_ &entry) {
+        auto &divisor = divisors_[entry.divisorIndex];
+
+        if (entry.quotientIndex == 0) {
+            if (auto nextTerm = std::next(entry.divisorTerm); nextTerm != divisor.polynomial->end()) {
+                Push_(entry.divisorIndex, 0, nextTerm);
+            }
+        }
+
+        if (entry.quotientIndex + 1 < divisor.quotient.size()) {
+            Push_(entry.divisorIndex, entry.quotientIndex + 1, entry.divisorTerm);
+        } else {
+            divisor.waitingColumns.push_back(entry.divisorTerm);
+        }
+    }
+
+    void AddQuotientTerm_(IndexType divisorIndex, const Monomial &monomial, const FieldType &coefficient) {
+        auto &divisor = divisors_[divisorIndex];
+        const auto &leadingTerm = divisor.polynomial->GetLeadingTerm();
+
+        divisor.quotient.emplace_back(monomial / leadingTerm.first, coefficient / leadingTerm.second);
+        ++reductionCount_;
+
+        IndexType quotientIndex = divisor.quotient.size() - 1;
+        if (quotientIndex == 0) {
+            if (auto firstTail = std::next(divisor.polynomial->begin()); firstTail != divisor.polynomial->end()) {
+                Push_(divisorIndex, 0, firstTail);
+            }
+        } else {
+            for (const auto &column : divisor.waitingColumns) {
+                Push_(divisorIndex, quotientIndex, column);
+            }
+            divisor.waitingColumns.clear();
+        }
+    }
+
+    ReducerSelection selection_;
+    ReductionStatistics statistics_;
+    std::vector<Divisor_> divisors_;
+    std::priority_queue<HeapEntry_, std::vector<HeapEntry_>, HeapEntryLess_> heap_;
+    MonomialOrder order_;
+    size_t reductionCount_ = 0;
+};
+
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+struct DivisionResult {
+    // quotients[i] belongs to the i-th divisor, dividend = sum quotients[i] * divisors[i] + remainder.
+    std::vector<Polynomial<FieldType, MonomialOrder>> quotients;
+    Polynomial<FieldType, MonomialOrder> remainder;
+};
+
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder, typename DivisorRange>
+DivisionResult<FieldType, MonomialOrder> Divide(
+        const Polynomial<FieldType, MonomialOrder> &dividend,
+        const DivisorRange &divisors)
+{
+    HeapDivision<FieldType, MonomialOrder> division(divisors);
+    auto remainder = division.Reduce(dividend);
+
+    return {division.GetQuotients(), std::move(remainder)};
+}
+
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder, typename DivisorRange>
+Polynomial<FieldType, MonomialOrder> HeapReduction(
+        const Polynomial<FieldType, MonomialOrder> &dividend,
+        const DivisorRange &divisors,
+        size_t *reductionCount = nullptr,
+        ReducerSelection selection = ReducerSelection::kFirst,
+        ReductionStatistics *statistics = nullptr)
+{
+    HeapDivision<FieldType, MonomialOrder> division(divisors, selection);
+    auto remainder = division.Reduce(dividend);
+
+    if (reductionCount != nullptr) {
+        *reductionCount = division.GetReductionCount();
+    }
+    if (statistics != nullptr) {
+        *statistics += division.GetStatistics();
+    }
+
+    return remainder;
+}
+
+// Reduces a dividend that is never materialized, e.g. an S-polynomial stream.
+template<TermStream Stream, typename DivisorRange>
+typename Stream::PolynomialType HeapReduction(
+        Stream dividend,
+        const DivisorRange &divisors,
+        size_t *reductionCount = nullptr,
+        ReducerSelection selection = ReducerSelection::kFirst,
+        ReductionStatistics *statistics = nullptr)
+{
+    using PolynomialType = typename Stream::PolynomialType;
+    using FieldType = typename PolynomialType::Term::second_type;
+    using MonomialOrder = typename PolynomialType::TermMap::key_compare;
+
+    HeapDivision<FieldType, MonomialOrder> division(divisors, selection);
+    auto remainder = division.Reduce(std::move(dividend));
+
+    if (reductionCount != nullptr) {
+        *reductionCount = division.GetReductionCount();
+    }
+    if (statistics != nullptr) {
+        *statistics += division.GetStatistics();
+    }
+
+    return remainder;
+}
+
+} // namespace GB
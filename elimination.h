@@ -0,0 +1,123 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "division.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace GB {
+
+// Splits the linear generators off, brings them to reduced row echelon form and
+// substitutes their pivot variables into the other generators. A Gröbner basis of
+// the remaining part is mapped back to one of the whole ideal by MapBack.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+class LinearElimination {
+public:
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using PolynomialSetType = PolynomialSet<FieldType, MonomialOrder>;
+
+    explicit LinearElimination(const PolynomialSetType &generators) {
+        std::vector<PolynomialType> pending;
+        for (const auto &generator : generators) {
+            if (!PolynomialType::IsZero(generator)) {
+                pending.push_back(generator);
+            }
+        }
+
+        // Substituting pivots may turn further generators linear, so repeat until nothing changes.
+        bool isChanged = true;
+        while (isChanged && !isInconsistent_) {
+            isChanged = false;
+            std::vector<PolynomialType> nonLinear;
+
+            for (auto &generator : pending) {
+                auto reduced = HeapReduction(generator, rows_);
+                if (PolynomialType::IsZero(reduced)) {
+                    continue;
+                }
+                if (IsLinear(reduced)) {
+                    AddRow_(std::move(reduced));
+                    isChanged = true;
+                    if (isInconsistent_) {
+                        break;
+                    }
+                } else {
+                    nonLinear.push_back(std::move(reduced));
+                }
+            }
+
+            pending = std::move(nonLinear);
+        }
+
+        if (!isInconsistent_) {
+            for (const auto &generator : pending) {
+                auto reduced = HeapReduction(generator, rows_);
+                if (!PolynomialType::IsZero(reduced)) {
+                    remaining_.insert(std::move(reduced));
+                }
+            }
+        }
+    }
+
+    static bool IsLinear(const PolynomialType &polynomial) {
+        return std::all_of(polynomial.begin(), polynomial.end(), [] (const auto &term) {
+            return term.first.TotalDegree() <= 1;
+        });
+    }
+
+    // True when the linear generators contradict each other, the ideal is then the whole ring.
+    [[nodiscard]] bool IsInconsistent() const noexcept {
+        return isInconsistent_;
+    }
+
+    // Monic linear polynomials with pairwise different leading variables, none of which occurs elsewhere.
+    [[nodiscard]] PolynomialSetType GetLinearPart() const {
+        return PolynomialSetType(rows_.begin(), rows_.end());
+    }
+
+    // Non-linear generators with all pivot variables substituted.
+    [[nodiscard]] const PolynomialSetType &GetRemainingPart() const noexcept {
+        return remaining_;
+    }
+
+    [[nodiscard]] size_t GetAmountOfEliminatedVariables() const noexcept {
+        return rows_.size();
+    }
+
+    // Leading variables of the linear part are coprime with every leading monomial of
+    // a basis of the remaining part, so their union is a Gröbner basis of the ideal.
+    PolynomialSetType MapBack(PolynomialSetType remainingBasis) const {
+        if (isInconsistent_) {
+            return {PolynomialType(FieldType(1))};
+        }
+
+        remainingBasis.insert(rows_.begin(), rows_.end());
+        OptimizeSet(remainingBasis);
+        return remainingBasis;
+    }
+
+private:
+    // One Gauss-Jordan step, the row is already reduced by the present ones.
+    void AddRow_(PolynomialType row) {
+        const auto leadingTerm = row.GetLeadingTerm();
+        if (Monomial::HasNoVariables(leadingTerm.first)) {
+            isInconsistent_ = true;
+            return;
+        }
+
+        row *= FieldType(1) / leadingTerm.second;
+        for (auto &other : rows_) {
+            other = HeapReduction(other, std::vector<PolynomialType>{row});
+        }
+        rows_.push_back(std::move(row));
+    }
+
+    std::vector<PolynomialType> rows_;
+    PolynomialSetType remaining_;
+    bool isInconsistent_ = false;
+};
+
+} // namespace GB
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace GB {
+
+// Compiled form of a polynomial for evaluation at many points at once.
+// Terms are flattened into a straight-line program: every term is a coefficient
+// followed by indices into a power table, and the table holds x_i^d for all
+// degrees occurring in the polynomial, so each power is computed once per point
+// and shared by all the terms. Points are processed in blocks and every step is a
+// loop over the points of a block, which the compiler vectorizes for doubles and
+// for word-size prime fields.
+template<typename ValueType>
+class BatchEvaluator {
+public:
+    using IndexType = Monomial::IndexType;
+
+    static constexpr size_t kBlockSize = 64;
+
+    // Coefficients are converted with static_cast, e.g. Rational<> to double or Modular<p> to itself.
+    template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+    explicit BatchEvaluator(const Polynomial<FieldType, MonomialOrder> &polynomial) {
+        for (const auto &[monomial, coefficient] : polynomial) {
+            if (maxDegrees_.size() < monomial.GetAmountOfVariables()) {
+                maxDegrees_.resize(monomial.GetAmountOfVariables());
+            }
+            for (IndexType variableIndex = 0; variableIndex < monomial.GetAmountOfVariables(); ++variableIndex) {
+                maxDegrees_[variableIndex] = std::max(maxDegrees_[variableIndex],
+                                                      static_cast<uint64_t>(monomial.GetDegree(variableIndex)));
+            }
+        }
+
+        // Row of x_i^d in the power table, d >= 1.
+        powerRowOffsets_.resize(maxDegrees_.size());
+        for (IndexType variableIndex = 0; variableIndex < maxDegrees_.size(); ++variableIndex) {
+            powerRowOffsets_[variableIndex] = amountOfPowerRows_;
+            amountOfPowerRows_ += maxDegrees_[variableIndex];
+        }
+
+        for (const auto &[monomial, coefficient] : polynomial) {
+            coefficients_.push_back(static_cast<ValueType>(coefficient));
+            for (IndexType variableIndex = 0; variableIndex < monomial.GetAmountOfVariables(); ++variableIndex) {
+                if (auto degree = static_cast<uint64_t>(monomial.GetDegree(variableIndex)); degree != 0) {
+                    factorRows_.push_back(powerRowOffsets_[variableIndex] + degree - 1);
+                }
+            }
+            termEnds_.push_back(factorRows_.size());
+        }
+    }
+
+    [[nodiscard]] IndexType GetAmountOfVariables() const noexcept {
+        return maxDegrees_.size();
+    }
+
+    ValueType Evaluate(const std::vector<ValueType> &point) const {
+        std::vector<std::vector<ValueType>> coordinates(point.size());
+        for (IndexType variableIndex = 0; variableIndex < point.size(); ++variableIndex) {
+            coordinates[variableIndex].push_back(point[variableIndex]);
+        }
+
+        return EvaluateBatch(coordinates).front();
+    }
+
+    // coordinates[i][j] is the value of x_i at the j-th point. Every variable
+    // of the polynomial needs a coordinate, extra ones are ignored.
+    std::vector<ValueType> EvaluateBatch(const std::vector<std::vector<ValueType>> &coordinates) const {
+        if (coordinates.size() < GetAmountOfVariables()) {
+            throw std::invalid_argument("Not enough coordinates for the polynomial");
+        }
+
+        size_t amountOfPoints = coordinates.empty() ? 1 : coordinates.front().size();
+        for (const auto &values : coordinates) {
+            if (values.size() != amountOfPoints) {
+                throw std::invalid_argument("Coordinates describe different amounts of points");
+            }
+        }
+
+        std::vector<ValueType> results(amountOfPoints);
+        std::vector<ValueType> powers(amountOfPowerRows_ * kBlockSize);
+        std::vector<ValueType> termValues(kBlockSize);
+
+        for (size_t blockStart = 0; blockStart < amountOfPoints; blockStart += kBlockSize) {
+            size_t blockSize = std::min(kBlockSize, amountOfPoints - blockStart);
+
+            FillPowers_(coordinates, blockStart, blockSize, powers.data());
+            AccumulateTerms_(powers.data(), blockSize, termValues.data(), results.data() + blockStart);
+        }
+
+        return results;
+    }
+
+private:
+    void FillPowers_(const std::vector<std::vector<ValueType>> &coordinates, size_t blockStart, size_t blockSize,
+                     ValueType *powers) const {
+        for (IndexType variableIndex = 0; variableIndex < maxDegrees_.size(); ++variableIndex) {
+            if (maxDegrees_[variableIndex] == 0) {
+                continue;
+            }
+
+            const ValueType *values = coordinates[variableIndex].data() + blockStart;
+            ValueType *row = powers + powerRowOffsets_[variableIndex] * kBlockSize;
+            for (size_t lane = 0; lane < blockSize; ++lane) {
+                row[lane] = values[lane];
+            }
+
+            for (uint64_t degree = 2; degree <= maxDegrees_[variableIndex]; ++degree) {
+                const ValueType *previous = row;
+                row += kBlockSize;
+                for (size_t lane = 0; lane < blockSize; ++lane) {
+                    row[lane] = previous[lane] * values[lane];
+                }
+            }
+        }
+    }
+
+    void AccumulateTerms_(const ValueType *powers, size_t blockSize, ValueType *termValues, ValueType *results) const {
+        size_t factor = 0;
+        for (size_t term = 0; term < coefficients_.size(); ++term) {
+            const ValueType coefficient = coefficients_[term];
+            for (size_t lane = 0; lane < blockSize; ++lane) {
+                termValues[lane] = coefficient;
+            }
+
+            for (; factor < termEnds_[term]; ++factor) {
+                const ValueType *row = powers + factorRows_[factor] * kBlockSize;
+                for (size_t lane = 0; lane < blockSize; ++lane) {
+                    termValues[lane] = termValues[lane] * row[lane];
+                }
+            }
+
+            for (size_t lane = 0; lane < blockSize; ++lane) {
+                results[lane] = results[lane] + termValues[lane];
+            }
+        }
+    }
+
+    std::vector<uint64_t> maxDegrees_;
+    std::vector<size_t> powerRowOffsets_;
+    size_t amountOfPowerRows_ = 0;
+
+    std::vector<ValueType> coefficients_;
+    // Power table rows multiplied into each term, the factors of term t end at termEnds_[t].
+    std::vector<size_t> factorRows_;
+    std::vector<size_t> termEnds_;
+};
+
+} // namespace GB
@@ -0,0 +1,617 @@
+#pragma once
+
+#include "concepts.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace GB {
+
+// Finite field GF(p^k) = F_p[a] / (f), where f is the first suitable monic polynomial
+// of degree k found by an exhaustive search. Fields with at most kMaxTableSize elements
+// take f primitive and store every non-zero element as its discrete logarithm, so the
+// product is an addition of logarithms and the sum goes through a table of Zech logarithms.
+// Larger fields store the coordinates in the basis 1, a, ..., a^{k-1}, multiply them as
+// polynomials and reduce the product with the precomputed residues of a^k, ..., a^{2k-2}.
+// Unlike an extra generator f(a) in the ideal, the coefficients never leave the field.
+template<uint32_t Characteristic, uint32_t Degree>
+class GaloisField {
+// The following class invariant is used:
+// for tabulated fields value is a logarithm, 0 <= value < q - 1, or kZeroLogarithm_;
+// otherwise every coordinate is a canonical representative, 0 <= coordinate < p.
+
+static_assert(Characteristic > 1 && Characteristic < (1u << 31), "Characteristic has to fit into 31 bits");
+static_assert(Degree > 0, "Degree of the extension has to be positive");
+
+public:
+    using Coordinates = std::array<uint32_t, Degree>;
+
+    static constexpr uint64_t kMaxTableSize = 1 << 16;
+
+    // Characteristic is expected to be prime.
+    GaloisField() noexcept : GaloisField(0) {
+    }
+
+    GaloisField(int64_t value) noexcept {
+        int64_t remainder = value % static_cast<int64_t>(Characteristic);
+        auto residue = static_cast<uint32_t>(remainder < 0 ? remainder + Characteristic : remainder);
+
+        if constexpr (kIsTabulated_) {
+            value_ = GetTables_().logarithms[residue];
+        } else {
+            value_ = {};
+            value_[0] = residue;
+        }
+    }
+
+    static GaloisField FromCoordinates(const Coordinates &coordinates) {
+        GaloisField result;
+        for (auto coordinate : coordinates) {
+            if (coordinate >= Characteristic) {
+                throw std::invalid_argument("Coordinate is not reduced modulo the characteristic");
+            }
+        }
+
+        if constexpr (kIsTabulated_) {
+            result.value_ = GetTables_().logarithms[Encode_(coordinates)];
+        } else {
+            result.value_ = coordinates;
+        }
+
+        return result;
+    }
+
+    // The class of a, a root of the defining polynomial. For tabulated fields it generates the multiplicative group.
+    static GaloisField GetGenerator() {
+        Coordinates one = {};
+        one[0] = 1;
+
+        return FromCoordinates(MultiplyByGenerator_(one, GetLeadingReduction_()));
+    }
+
+    // Coefficients c_0, ..., c_{k-1} of the monic defining polynomial a^k + c_{k-1} a^{k-1} + ... + c_0.
+    static const Coordinates &GetDefiningPolynomial() {
+        return GetTables_().definingPolynomial;
+    }
+
+    static constexpr uint32_t GetCharacteristic() noexcept {
+        return Characteristic;
+    }
+
+    static constexpr uint32_t GetDegree() noexcept {
+        return Degree;
+    }
+
+    [[nodiscard]] Coordinates GetCoordinates() const noexcept {
+        if constexpr (kIsTabulated_) {
+            return value_ == kZeroLogarithm_ ? Coordinates{} : Decode_(GetTables_().exponents[value_]);
+        } else {
+            return value_;
+        }
+    }
+
+    void Invert() {
+        if (*this == GaloisField()) {
+            throw std::overflow_error("Divide by zero exception");
+        }
+
+        if constexpr (kIsTabulated_) {
+            value_ = value_ == 0 ? 0 : kOrder_ - 1 - value_;
+        } else {
+            // Itoh-Tsujii: with r = (q - 1) / (p - 1), the norm x^r lies in F_p and
+            // x^{r - 1} is the product of the conjugates x^p, ..., x^{p^{k-1}}.
+            GaloisField conjugate = *this;
+            GaloisField conjugateProduct = 1;
+            for (uint32_t power = 1; power < Degree; ++power) {
+                conjugate = Pow(conjugate, Characteristic);
+                conjugateProduct *= conjugate;
+            }
+
+            auto norm = (*this * conjugateProduct).value_[0];
+            *this = conjugateProduct * GaloisField(InvertResidue_(norm));
+        }
+    }
+
+    GaloisField GetInverted() const {
+        GaloisField result = *this;
+
+        result.Invert();
+        return result;
+    }
+
+    static GaloisField Pow(GaloisField base, uint64_t exponent) noexcept {
+        GaloisField result = 1;
+        while (exponent != 0) {
+            if (exponent & 1) {
+                result *= base;
+            }
+            base *= base;
+            exponent >>= 1;
+        }
+
+        return result;
+    }
+
+    GaloisField operator+() const noexcept {
+        GaloisField result = *this;
+
+        return result;
+    }
+
+    GaloisField operator-() const noexcept {
+        GaloisField result = *this;
+        if constexpr (kIsTabulated_) {
+            if (value_ != kZeroLogarithm_) {
+                result.value_ = AddLogarithms_(value_, GetTables_().minusOneLogarithm);
+            }
+        } else {
+            for (auto &coordinate : result.value_) {
+                coordinate = coordinate == 0 ? 0 : Characteristic - coordinate;
+            }
+        }
+
+        return result;
+    }
+
+    GaloisField &operator+=(const GaloisField &other) noexcept {
+        if constexpr (kIsTabulated_) {
+            if (other.value_ == kZeroLogarithm_) {
+                return *this;
+            }
+            if (value_ == kZeroLogarithm_) {
+                value_ = other.value_;
+                return *this;
+            }
+
+            // x^i + x^j = x^i (1 + x^{j - i}), and 1 + x^n = x^{zech[n]}.
+            auto zech = GetTables_().zechLogarithms[SubtractLogarithms_(other.value_, value_)];
+            value_ = zech == kZeroLogarithm_ ? kZeroLogarithm_ : AddLogarithms_(value_, zech);
+        } else {
+            for (uint32_t index = 0; index < Degree; ++index) {
+                value_[index] = AddResidues_(value_[index], other.value_[index]);
+            }
+        }
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    GaloisField &operator-=(const GaloisField &other) noexcept {
+        *this += -other;
+
+        return *this;
+    }
+
+    GaloisField &operator*=(const GaloisField &other) noexcept {
+        if constexpr (kIsTabulated_) {
+            if (value_ == kZeroLogarithm_ || other.value_ == kZeroLogarithm_) {
+                value_ = kZeroLogarithm_;
+            } else {
+                value_ = AddLogarithms_(value_, other.value_);
+            }
+        } else {
+            std::array<uint32_t, 2 * Degree - 1> product = {};
+            for (uint32_t i = 0; i < Degree; ++i) {
+                if (value_[i] == 0) {
+                    continue;
+                }
+                for (uint32_t j = 0; j < Degree; ++j) {
+                    product[i + j] = AddResidues_(product[i + j], MultiplyResidues_(value_[i], other.value_[j]));
+                }
+            }
+
+            const auto &reductions = GetTables_().reductions;
+            for (uint32_t power = 2 * Degree - 2; power >= Degree; --power) {
+                if (product[power] == 0) {
+                    continue;
+                }
+                for (uint32_t index = 0; index < Degree; ++index) {
+                    product[index] = AddResidues_(product[index],
+                                                  MultiplyResidues_(product[power], reductions[power - Degree][index]));
+                }
+            }
+
+            std::copy(product.begin(), product.begin() + Degree, value_.begin());
+        }
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    GaloisField &operator/=(const GaloisField &other) {
+        *this *= other.GetInverted();
+
+        return *this;
+    }
+
+    friend GaloisField operator+(const GaloisField &lhs, const GaloisField &rhs) noexcept {
+        GaloisField result = lhs;
+        result += rhs;
+
+        return result;
+    }
+
+    friend GaloisField operator-(const GaloisField &lhs, const GaloisField &rhs) noexcept {
+        GaloisField result = lhs;
+        result -= rhs;
+
+        return result;
+    }
+
+    friend GaloisField operator*(const GaloisField &lhs, const GaloisField &rhs) noexcept {
+        GaloisField result = lhs;
+        result *= rhs;
+
+        return result;
+    }
+
+    friend GaloisField operator/(const GaloisField &lhs, const GaloisField &rhs) {
+        GaloisField result = lhs;
+        result /= rhs;
+
+        return result;
+    }
+
+    friend bool operator==(const GaloisField &lhs, const GaloisField &rhs) noexcept {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend bool operator!=(const GaloisField &lhs, const GaloisField &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    // The field is not ordered, this compares coordinates from the highest power of a
+    // so that elements can be printed and stored in ordered containers.
+    friend bool operator<(const GaloisField &lhs, const GaloisField &rhs) noexcept {
+        auto lhsCoordinates = lhs.GetCoordinates();
+        auto rhsCoordinates = rhs.GetCoordinates();
+
+        return std::lexicographical_compare(lhsCoordinates.rbegin(), lhsCoordinates.rend(),
+                                            rhsCoordinates.rbegin(), rhsCoordinates.rend());
+    }
+
+    // Elements outside of F_p are printed as polynomials in a, e.g. (2a^2 + 1).
+    friend std::ostream &operator<<(std::ostream &out, const GaloisField &other) {
+        auto coordinates = other.GetCoordinates();
+        if (std::all_of(coordinates.begin() + 1, coordinates.end(), [] (uint32_t coordinate) { return coordinate == 0; })) {
+            out << coordinates[0];
+            return out;
+        }
+
+        out << "(";
+        bool isFirst = true;
+        for (uint32_t power = Degree; power-- > 0;) {
+            if (coordinates[power] == 0) {
+                continue;
+            }
+            if (!isFirst) {
+                out << " + ";
+            }
+            isFirst = false;
+
+            if (coordinates[power] != 1 || power == 0) {
+                out << coordinates[power];
+            }
+            if (power != 0) {
+                out << "a";
+            }
+            if (power > 1) {
+                out << "^" << power;
+            }
+        }
+        out << ")";
+
+        return out;
+    }
+
+private:
+    static constexpr uint64_t ComputeTabulatedOrder_() {
+        uint64_t order = 1;
+        for (uint32_t power = 0; power < Degree; ++power) {
+            if (order * Characteristic > kMaxTableSize) {
+                return 0;
+            }
+            order *= Characteristic;
+        }
+
+        return order;
+    }
+
+    // q for tabulated fields, 0 otherwise.
+    static constexpr uint64_t kOrder_ = ComputeTabulatedOrder_();
+    static constexpr bool kIsTabulated_ = kOrder_ != 0;
+    static constexpr uint32_t kZeroLogarithm_ = kIsTabulated_ ? static_cast<uint32_t>(kOrder_ - 1) : 0;
+
+    using Storage_ = std::conditional_t<kIsTabulated_, uint32_t, Coordinates>;
+    // Dense polynomial over F_p, the lowest coefficient first.
+    using ResiduePolynomial_ = std::vector<uint32_t>;
+
+    struct Tables_ {
+        Coordinates definingPolynomial = {};
+
+        // Tabulated fields: exponents[i] encodes a^i, logarithms[encoding] is the inverse map
+        // and zechLogarithms[n] is the logarithm of 1 + a^n.
+        std::vector<uint32_t> exponents;
+        std::vector<uint32_t> logarithms;
+        std::vector<uint32_t> zechLogarithms;
+        uint32_t minusOneLogarithm = 0;
+
+        // Other fields: reductions[i] are the coordinates of a^{k + i}.
+        std::vector<Coordinates> reductions;
+    };
+
+    static const Tables_ &GetTables_() {
+        static const Tables_ tables = BuildTables_();
+        return tables;
+    }
+
+    static Tables_ BuildTables_() {
+        Tables_ tables;
+
+        // Candidates a^k + c_{k-1} a^{k-1} + ... + c_0 with c_0 != 0, c counts in base p.
+        Coordinates candidate = {};
+        candidate[0] = 1;
+        while (true) {
+            if constexpr (kIsTabulated_) {
+                if (TryTabulate_(candidate, tables)) {
+                    break;
+                }
+            } else {
+                if (IsIrreducible_(candidate)) {
+                    break;
+                }
+            }
+
+            uint32_t index = 0;
+            while (index < Degree && ++candidate[index] == Characteristic) {
+                candidate[index++] = 0;
+            }
+            if (index == Degree) {
+                throw std::logic_error("No irreducible polynomial found, is the characteristic prime?");
+            }
+        }
+        tables.definingPolynomial = candidate;
+
+        if constexpr (!kIsTabulated_) {
+            // Each next power of a is the previous one times a.
+            Coordinates power = GetLeadingReduction_(candidate);
+            for (uint32_t step = 0; step + 1 < Degree; ++step) {
+                tables.reductions.push_back(power);
+                power = MultiplyByGenerator_(power, tables.reductions.front());
+            }
+        }
+
+        return tables;
+    }
+
+    // Coordinates of a^k = -(c_{k-1} a^{k-1} + ... + c_0).
+    static Coordinates GetLeadingReduction_(const Coordinates &definingPolynomial = GetDefiningPolynomial()) {
+        Coordinates reduction = {};
+        for (uint32_t index = 0; index < Degree; ++index) {
+            reduction[index] = definingPolynomial[index] == 0 ? 0 : Characteristic - definingPolynomial[index];
+        }
+
+        return reduction;
+    }
+
+    // Walks the powers of a modulo the candidate, which is primitive iff they cover all of F_q^*.
+    static bool TryTabulate_(const Coordinates &candidate, Tables_ &tables) {
+        Coordinates reduction = GetLeadingReduction_(candidate);
+
+        tables.exponents.assign(kOrder_ - 1, 0);
+        tables.logarithms.assign(kOrder_, kZeroLogarithm_);
+
+        Coordinates power = {};
+        power[0] = 1;
+        for (uint32_t logarithm = 0; logarithm < kOrder_ - 1; ++logarithm) {
+            auto encoding = Encode_(power);
+            if (tables.logarithms[encoding] != kZeroLogarithm_ || encoding == 0) {
+                return false;
+            }
+            tables.exponents[logarithm] = encoding;
+            tables.logarithms[encoding] = logarithm;
+
+            power = MultiplyByGenerator_(power, reduction);
+        }
+
+        tables.zechLogarithms.resize(kOrder_ - 1);
+        for (uint32_t logarithm = 0; logarithm < kOrder_ - 1; ++logarithm) {
+            auto encoding = tables.exponents[logarithm];
+            auto constant = encoding % Characteristic;
+            encoding = constant + 1 == Characteristic ? encoding - constant : encoding + 1;
+            tables.zechLogarithms[logarithm] = tables.logarithms[encoding];
+        }
+        tables.minusOneLogarithm = tables.logarithms[Characteristic - 1];
+
+        return true;
+    }
+
+    // Multiplies by a, the given reduction holds the coordinates of a^k.
+    static Coordinates MultiplyByGenerator_(const Coordinates &element, const Coordinates &reduction) {
+        Coordinates result = {};
+        for (uint32_t index = 0; index + 1 < Degree; ++index) {
+            result[index + 1] = element[index];
+        }
+        for (uint32_t index = 0; index < Degree; ++index) {
+            result[index] = AddResidues_(result[index], MultiplyResidues_(element[Degree - 1], reduction[index]));
+        }
+
+        return result;
+    }
+
+    static uint32_t Encode_(const Coordinates &coordinates) {
+        uint32_t encoding = 0;
+        for (uint32_t index = Degree; index-- > 0;) {
+            encoding = encoding * Characteristic + coordinates[index];
+        }
+
+        return encoding;
+    }
+
+    static Coordinates Decode_(uint32_t encoding) {
+        Coordinates coordinates = {};
+        for (uint32_t index = 0; index < Degree; ++index) {
+            coordinates[index] = encoding % Characteristic;
+            encoding /= Characteristic;
+        }
+
+        return coordinates;
+    }
+
+    // Rabin's test: f of degree k is irreducible iff a^{p^k} = a modulo f and
+    // gcd(a^{p^{k/r}} - a, f) = 1 for every prime r dividing k.
+    static bool IsIrreducible_(const Coordinates &candidate) {
+        ResiduePolynomial_ modulus(candidate.begin(), candidate.end());
+        modulus.push_back(1);
+
+        auto frobeniusPower = [&] (uint32_t times) {
+            ResiduePolynomial_ power = {0, 1};
+            for (uint32_t step = 0; step < times; ++step) {
+                power = PowModulo_(power, Characteristic, modulus);
+            }
+            return power;
+        };
+        auto subtractGenerator = [&] (ResiduePolynomial_ polynomial) {
+            polynomial.resize(std::max<size_t>(polynomial.size(), 2));
+            polynomial[1] = AddResidues_(polynomial[1], Characteristic - 1);
+            return Remainder_(std::move(polynomial), modulus);
+        };
+
+        if (!subtractGenerator(frobeniusPower(Degree)).empty()) {
+            return false;
+        }
+
+        uint32_t rest = Degree;
+        for (uint32_t prime = 2; prime <= rest; ++prime) {
+            if (rest % prime != 0) {
+                continue;
+            }
+            while (rest % prime == 0) {
+                rest /= prime;
+            }
+            if (Gcd_(subtractGenerator(frobeniusPower(Degree / prime)), modulus).size() != 1) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static void Trim_(ResiduePolynomial_ &polynomial) {
+        while (!polynomial.empty() && polynomial.back() == 0) {
+            polynomial.pop_back();
+        }
+    }
+
+    static ResiduePolynomial_ Remainder_(ResiduePolynomial_ dividend, const ResiduePolynomial_ &divisor) {
+        auto leadingInverse = InvertResidue_(divisor.back());
+        Trim_(dividend);
+        while (dividend.size() >= divisor.size()) {
+            auto factor = MultiplyResidues_(dividend.back(), leadingInverse);
+            auto shift = dividend.size() - divisor.size();
+            for (size_t index = 0; index < divisor.size(); ++index) {
+                dividend[shift + index] = AddResidues_(dividend[shift + index],
+                                                       Characteristic - MultiplyResidues_(factor, divisor[index]));
+            }
+            Trim_(dividend);
+        }
+
+        return dividend;
+    }
+
+    static ResiduePolynomial_ PowModulo_(ResiduePolynomial_ base, uint64_t exponent, const ResiduePolynomial_ &modulus) {
+        auto multiply = [&] (const ResiduePolynomial_ &lhs, const ResiduePolynomial_ &rhs) {
+            if (lhs.empty() || rhs.empty()) {
+                return ResiduePolynomial_();
+            }
+            ResiduePolynomial_ product(lhs.size() + rhs.size() - 1);
+            for (size_t i = 0; i < lhs.size(); ++i) {
+                for (size_t j = 0; j < rhs.size(); ++j) {
+                    product[i + j] = AddResidues_(product[i + j], MultiplyResidues_(lhs[i], rhs[j]));
+                }
+            }
+            return Remainder_(std::move(product), modulus);
+        };
+
+        ResiduePolynomial_ result = {1};
+        base = Remainder_(std::move(base), modulus);
+        while (exponent != 0) {
+            if (exponent & 1) {
+                result = multiply(result, base);
+            }
+            base = multiply(base, base);
+            exponent >>= 1;
+        }
+
+        return result;
+    }
+
+    // Non-zero result up to a constant factor, a constant for coprime arguments.
+    static ResiduePolynomial_ Gcd_(ResiduePolynomial_ lhs, ResiduePolynomial_ rhs) {
+        Trim_(lhs);
+        Trim_(rhs);
+        while (!rhs.empty()) {
+            lhs = Remainder_(std::move(lhs), rhs);
+            std::swap(lhs, rhs);
+        }
+
+        return lhs;
+    }
+
+    static uint32_t AddResidues_(uint32_t lhs, uint32_t rhs) noexcept {
+        uint32_t sum = lhs + rhs;
+        return sum >= Characteristic ? sum - Characteristic : sum;
+    }
+
+    static uint32_t MultiplyResidues_(uint32_t lhs, uint32_t rhs) noexcept {
+        return static_cast<uint32_t>(static_cast<uint64_t>(lhs) * rhs % Characteristic);
+    }
+
+    static uint32_t InvertResidue_(uint32_t value) noexcept {
+        uint32_t result = 1;
+        for (uint64_t exponent = Characteristic - 2; exponent != 0; exponent >>= 1) {
+            if (exponent & 1) {
+                result = MultiplyResidues_(result, value);
+            }
+            value = MultiplyResidues_(value, value);
+        }
+
+        return result;
+    }
+
+    static uint32_t AddLogarithms_(uint32_t lhs, uint32_t rhs) noexcept {
+        uint64_t sum = static_cast<uint64_t>(lhs) + rhs;
+        return static_cast<uint32_t>(sum >= kOrder_ - 1 ? sum - (kOrder_ - 1) : sum);
+    }
+
+    static uint32_t SubtractLogarithms_(uint32_t lhs, uint32_t rhs) noexcept {
+        return lhs >= rhs ? lhs - rhs : static_cast<uint32_t>(lhs + (kOrder_ - 1) - rhs);
+    }
+
+    void CheckInvariants_() const noexcept {
+        if constexpr (kIsTabulated_) {
+            assert(value_ < kOrder_);
+        } else {
+            for (auto coordinate : value_) {
+                assert(coordinate < Characteristic);
+            }
+        }
+    }
+
+    Storage_ value_;
+};
+
+// The field is not ordered, so the absolute value is the element itself.
+template<uint32_t Characteristic, uint32_t Degree>
+GaloisField<Characteristic, Degree> abs(const GaloisField<Characteristic, Degree> &other) {
+    return other;
+}
+
+} // namespace GB
@@ -0,0 +1,334 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+
+#include <cstdint>
+
+#include <bit>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace GB {
+
+class GF2 {
+public:
+    GF2() noexcept : value_(false) {
+    }
+
+    GF2(int64_t value) noexcept : value_(value & 1) {
+    }
+
+    static constexpr uint32_t GetModulus() noexcept {
+        return 2;
+    }
+
+    [[nodiscard]] uint32_t GetValue() const noexcept {
+        return value_;
+    }
+
+    void Invert() {
+        if (!value_) {
+            throw std::overflow_error("Divide by zero exception");
+        }
+    }
+
+    GF2 GetInverted() const {
+        GF2 result = *this;
+
+        result.Invert();
+        return result;
+    }
+
+    GF2 operator+() const noexcept {
+        return *this;
+    }
+
+    GF2 operator-() const noexcept {
+        return *this;
+    }
+
+    GF2 &operator+=(const GF2 &other) noexcept {
+        value_ ^= other.value_;
+        return *this;
+    }
+
+    GF2 &operator-=(const GF2 &other) noexcept {
+        value_ ^= other.value_;
+        return *this;
+    }
+
+    GF2 &operator*=(const GF2 &other) noexcept {
+        value_ &= other.value_;
+        return *this;
+    }
+
+    GF2 &operator/=(const GF2 &other) {
+        other.GetInverted();
+        return *this;
+    }
+
+    friend GF2 operator+(const GF2 &lhs, const GF2 &rhs) noexcept {
+        GF2 result = lhs;
+        result += rhs;
+
+        return result;
+    }
+
+    friend GF2 operator-(const GF2 &lhs, const GF2 &rhs) noexcept {
+        GF2 result = lhs;
+        result -= rhs;
+
+        return result;
+    }
+
+    friend GF2 operator*(const GF2 &lhs, const GF2 &rhs) noexcept {
+        GF2 result = lhs;
+        result *= rhs;
+
+        return result;
+    }
+
+    friend GF2 operator/(const GF2 &lhs, const GF2 &rhs) {
+        GF2 result = lhs;
+        result /= rhs;
+
+        return result;
+    }
+
+    friend bool operator==(const GF2 &lhs, const GF2 &rhs) noexcept {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend bool operator!=(const GF2 &lhs, const GF2 &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const GF2 &lhs, const GF2 &rhs) noexcept {
+        return lhs.value_ < rhs.value_;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const GF2 &other) {
+        out << other.value_;
+        return out;
+    }
+
+private:
+    bool value_;
+};
+
+inline GF2 abs(const GF2 &other) {
+    return other;
+}
+
+// Row of a matrix over GF(2) packed into machine words, addition of rows is a word-wise XOR.
+class BitRow {
+public:
+    using IndexType = size_t;
+
+    static constexpr IndexType kWordSize = 64;
+
+    BitRow() = default;
+
+    explicit BitRow(IndexType size) : words_((size + kWordSize - 1) / kWordSize) {
+    }
+
+    [[nodiscard]] bool Test(IndexType index) const noexcept {
+        return (words_[index / kWordSize] >> (index % kWordSize)) & 1;
+    }
+
+    void Flip(IndexType index) noexcept {
+        words_[index / kWordSize] ^= uint64_t(1) << (index % kWordSize);
+    }
+
+    // Index of the lowest set bit starting from the given word, or npos for a zero row.
+    [[nodiscard]] IndexType FindFirst(IndexType fromWord = 0) const noexcept {
+        for (IndexType word = fromWord; word < words_.size(); ++word) {
+            if (words_[word] != 0) {
+                return word * kWordSize + std::countr_zero(words_[word]);
+            }
+        }
+
+        return npos;
+    }
+
+    // Both rows are zero before fromWord, so the XOR may skip those words.
+    void XorWith(const BitRow &other, IndexType fromWord = 0) noexcept {
+        assert(words_.size() == other.words_.size());
+
+        uint64_t *__restrict target = words_.data();
+        const uint64_t *__restrict source = other.words_.data();
+        for (IndexType word = fromWord; word < words_.size(); ++word) {
+            target[word] ^= source[word];
+        }
+    }
+
+    static constexpr IndexType npos = static_cast<IndexType>(-1);
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+// One F4-style step over GF(2): the S-polynomials of all the pairs are written as rows
+// of a Macaulay matrix together with the monomial multiples of basis elements needed to
+// reduce them (symbolic preprocessing), and the matrix is echelonized with XORs of bit rows.
+// Every row left with a new leading monomial is a new basis element, and when there is none
+// all S-polynomials reduce to zero. Coefficients are implicit, so a row is just a bitset.
+template<SuitableOrder<Monomial> MonomialOrder>
+class GF2MacaulayMatrix {
+public:
+    using PolynomialType = Polynomial<GF2, MonomialOrder>;
+    using IndexType = size_t;
+
+    template<typename BasisRange>
+    explicit GF2MacaulayMatrix(const BasisRange &basis) {
+        for (const auto &polynomial : basis) {
+            if (!PolynomialType::IsZero(polynomial)) {
+                basis_.push_back(&polynomial);
+            }
+        }
+    }
+
+    void AddSPolynomial(const PolynomialType &first, const PolynomialType &second) {
+        const auto &l1 = first.GetLeadingTerm().first;
+        const auto &l2 = second.GetLeadingTerm().first;
+        const auto termsLCM = Lcm(l1, l2);
+
+        std::vector<Monomial> row;
+        AppendMultiple_(row, termsLCM / l1, first);
+        AppendMultiple_(row, termsLCM / l2, second);
+        rows_.push_back(std::move(row));
+    }
+
+    // Returns the rows with new leading monomials after the elimination.
+    PolynomialSet<GF2, MonomialOrder> Reduce() {
+        std::vector<std::vector<Monomial>> reducers = SymbolicPreprocessing_();
+
+        std::vector<Monomial> columnMonomials;
+        columnMonomials.reserve(columns_.size());
+        for (auto iter = columns_.rbegin(); iter != columns_.rend(); ++iter) {
+            iter->second = columnMonomials.size();
+            columnMonomials.push_back(iter->first);
+        }
+
+        std::vector<BitRow> pivots(columnMonomials.size());
+        std::vector<bool> hasPivot(columnMonomials.size());
+
+        for (const auto &reducer : reducers) {
+            BitRow row = ToBitRow_(reducer);
+            IndexType column = columns_.at(reducer.front());
+            hasPivot[column] = true;
+            pivots[column] = std::move(row);
+        }
+
+        std::vector<IndexType> newPivotColumns;
+        for (const auto &monomials : rows_) {
+            BitRow row = ToBitRow_(monomials);
+
+            for (IndexType column = row.FindFirst(); column != BitRow::npos;
+                 column = row.FindFirst(column / BitRow::kWordSize)) {
+                if (!hasPivot[column]) {
+                    hasPivot[column] = true;
+                    pivots[column] = std::move(row);
+                    newPivotColumns.push_back(column);
+                    break;
+                }
+                row.XorWith(pivots[column], column / BitRow::kWordSize);
+            }
+        }
+
+        PolynomialSet<GF2, MonomialOrder> result;
+        for (auto column : newPivotColumns) {
+            PolynomialType polynomial;
+            const auto &row = pivots[column];
+            for (IndexType index = column; index < columnMonomials.size(); ++index) {
+                if (row.Test(index)) {
+                    polynomial.PushBackTerm(columnMonomials[index], 1);
+                }
+            }
+            result.insert(std::move(polynomial));
+        }
+
+        return result;
+    }
+
+private:
+    void AppendMultiple_(std::vector<Monomial> &row, const Monomial &multiplier, const PolynomialType &polynomial) {
+        for (const auto &[monomial, coefficient] : polynomial) {
+            row.push_back(multiplier * monomial);
+        }
+    }
+
+    std::vector<std::vector<Monomial>> SymbolicPreprocessing_() {
+        std::vector<Monomial> worklist;
+        for (const auto &row : rows_) {
+            for (const auto &monomial : row) {
+                if (columns_.emplace(monomial, 0).second) {
+                    worklist.push_back(monomial);
+                }
+            }
+        }
+
+        std::vector<std::vector<Monomial>> reducers;
+        while (!worklist.empty()) {
+            Monomial monomial = std::move(worklist.back());
+            worklist.pop_back();
+
+            for (const auto *polynomial : basis_) {
+                const auto &leading = polynomial->GetLeadingTerm().first;
+                if (!monomial.IsDivisibleBy(leading)) {
+                    continue;
+                }
+
+                std::vector<Monomial> reducer;
+                AppendMultiple_(reducer, monomial / leading, *polynomial);
+                for (const auto &reducerMonomial : reducer) {
+                    if (columns_.emplace(reducerMonomial, 0).second) {
+                        worklist.push_back(reducerMonomial);
+                    }
+                }
+                reducers.push_back(std::move(reducer));
+                break;
+            }
+        }
+
+        return reducers;
+    }
+
+    // Monomials of an S-polynomial come from two multiples and may cancel, hence Flip instead of a set.
+    BitRow ToBitRow_(const std::vector<Monomial> &monomials) const {
+        BitRow row(columns_.size());
+        for (const auto &monomial : monomials) {
+            row.Flip(columns_.at(monomial));
+        }
+
+        return row;
+    }
+
+    std::vector<const PolynomialType *> basis_;
+    std::vector<std::vector<Monomial>> rows_;
+    // Column of every monomial, the largest monomial is in column 0.
+    std::map<Monomial, IndexType, MonomialOrder> columns_;
+};
+
+// Over GF(2) the pairs are reduced all at once by bit-packed linear algebra instead
+// of one S-polynomial at a time, BuhbergerAlgorithm picks this overload up through ADL.
+template<SuitableOrder<Monomial> MonomialOrder>
+PolynomialSet<GF2, MonomialOrder> FindPairs(const PolynomialSet<GF2, MonomialOrder> &set) {
+    GF2MacaulayMatrix<MonomialOrder> matrix(set);
+
+    for (auto first = set.begin(); first != set.end(); ++first) {
+        for (auto second = set.begin(); second != first; ++second) {
+            if (!CheckLeadingTermsCoprime(*first, *second)) {
+                matrix.AddSPolynomial(*first, *second);
+            }
+        }
+    }
+
+    return matrix.Reduce();
+}
+
+} // namespace GB
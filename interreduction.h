@@ -0,0 +1,101 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "division.h"
+#include "modular.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace GB {
+
+// Turns a Gröbner basis into the reduced one, what OptimizeSet does sequentially. Elements
+// whose leading monomial is divisible by another one are dropped first, after that the
+// leading monomials do not change any more. A term of the tail of g is smaller than LM(g),
+// so LM(g) divides none of the terms met while the tail is reduced by the whole basis, and
+// every element is reduced and normalized independently of the others. Only valid for sets
+// which are Gröbner bases, for others the result may generate a smaller ideal.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+void ParallelInterreduction(PolynomialSet<FieldType, MonomialOrder> &set, size_t amountOfThreads = 0) {
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+
+    std::vector<PolynomialType> basis;
+    for (const auto &polynomial : set) {
+        if (!PolynomialType::IsZero(polynomial)) {
+            basis.push_back(polynomial);
+        }
+    }
+
+    // Of the elements with equal leading monomials the first one stays.
+    std::vector<PolynomialType> minimal;
+    for (size_t index = 0; index < basis.size(); ++index) {
+        const auto leading = basis[index].GetLeadingTerm().first;
+        bool isRedundant = false;
+        for (size_t other = 0; other < basis.size() && !isRedundant; ++other) {
+            const auto otherLeading = basis[other].GetLeadingTerm().first;
+            isRedundant = other != index && leading.IsDivisibleBy(otherLeading) &&
+                          (otherLeading != leading || other < index);
+        }
+        if (!isRedundant) {
+            minimal.push_back(basis[index]);
+        }
+    }
+
+    std::vector<PolynomialType> reduced(minimal.size());
+    std::atomic<size_t> nextElement = 0;
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+    [[maybe_unused]] uint32_t modulus = 0;
+    if constexpr (std::is_same_v<FieldType, RuntimeModular>) {
+        modulus = RuntimeModular::GetCurrentModulus();
+    }
+
+    auto work = [&] {
+        try {
+            // The modulus of RuntimeModular is thread-local, the workers inherit the caller's one.
+            std::optional<RuntimeModular::ModulusScope> scope;
+            if constexpr (std::is_same_v<FieldType, RuntimeModular>) {
+                scope.emplace(modulus);
+            }
+
+            for (size_t index = nextElement++; index < minimal.size(); index = nextElement++) {
+                const auto &element = minimal[index];
+                PolynomialType leading(element.GetLeadingTerm());
+                auto polynomial = leading + HeapReduction(element - leading, minimal);
+                reduced[index] = polynomial * (FieldType(1) / element.GetLeadingTerm().second);
+            }
+        } catch (...) {
+            std::lock_guard lock(exceptionMutex);
+            exception = std::current_exception();
+        }
+    };
+
+    if (amountOfThreads == 0) {
+        amountOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    amountOfThreads = std::max<size_t>(1, std::min(amountOfThreads, minimal.size()));
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 1; thread < amountOfThreads; ++thread) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    set = PolynomialSet<FieldType, MonomialOrder>(reduced.begin(), reduced.end());
+}
+
+} // namespace GB
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "concepts.h"
+#include "monomial.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace GB {
+
+// Multiplication of dense polynomials over Z/pZ through Kronecker substitution:
+// x_i -> y^(stride_i) turns both operands into univariate polynomials without collisions,
+// their product is computed by number-theoretic transforms and then unpacked back.
+// The transforms run over three fixed NTT-friendly primes and the exact integer product
+// is recovered by the Chinese remainder theorem, so any modulus below 2^31 is supported.
+class KroneckerMultiplier {
+public:
+    using IndexType = Monomial::IndexType;
+
+    // Products with fewer terms on either side are never dense enough to be worth a transform.
+    static constexpr size_t kMinAmountOfTerms = 16;
+
+    // Transform size is limited by the 2-adic order of the smallest NTT prime.
+    static constexpr size_t kMaxTransformLength = size_t(1) << 23;
+
+    // Ratio between the cost of one sparse term product (a map insertion) and
+    // one butterfly of a single transform, measured on the sparse operator*.
+    static constexpr size_t kSparseProductCost = 24;
+
+    template<PrimeFieldType FieldType, typename TermMap>
+    static bool IsWorthwhile(const TermMap &lhs, const TermMap &rhs) {
+        if constexpr (FieldType::GetModulus() >= (uint64_t(1) << 31)) {
+            return false;
+        }
+
+        if (lhs.size() < kMinAmountOfTerms || rhs.size() < kMinAmountOfTerms) {
+            return false;
+        }
+
+        auto layout = ComputeLayout_(lhs, rhs);
+        if (!layout.has_value()) {
+            return false;
+        }
+
+        size_t length = TransformLength_(layout->productLength);
+        size_t logLength = 0;
+        while ((size_t(1) << logLength) < length) {
+            ++logLength;
+        }
+
+        // Three primes, three transforms each.
+        size_t transformCost = 9 * length * std::max<size_t>(logLength, 1);
+        size_t sparseCost = lhs.size() * rhs.size() * kSparseProductCost;
+
+        return transformCost < sparseCost;
+    }
+
+    template<PrimeFieldType FieldType, typename TermMap>
+    static TermMap Multiply(const TermMap &lhs, const TermMap &rhs) {
+        TermMap result;
+        if (lhs.empty() || rhs.empty()) {
+            return result;
+        }
+
+        auto layout = ComputeLayout_(lhs, rhs);
+        assert(layout.has_value());
+
+        std::vector<uint32_t> lhsValues = Pack_(lhs, *layout);
+        std::vector<uint32_t> rhsValues = Pack_(rhs, *layout);
+        size_t length = TransformLength_(layout->productLength);
+
+        std::array<std::vector<uint32_t>, kPrimes.size()> residues;
+        for (size_t primeIndex = 0; primeIndex < kPrimes.size(); ++primeIndex) {
+            residues[primeIndex] = Convolve_(lhsValues, rhsValues, length, kPrimes[primeIndex]);
+        }
+
+        const uint64_t modulus = FieldType::GetModulus();
+        Monomial::DegreeVector degrees(layout->bounds.size());
+        for (size_t index = 0; index < layout->productLength; ++index) {
+            uint64_t value = Reconstruct_(residues[0][index], residues[1][index], residues[2][index], modulus);
+            if (value == 0) {
+                continue;
+            }
+
+            size_t rest = index;
+            for (IndexType variableIndex = 0; variableIndex < degrees.size(); ++variableIndex) {
+                degrees[variableIndex] = rest % layout->bounds[variableIndex];
+                rest /= layout->bounds[variableIndex];
+            }
+
+            result.emplace(Monomial(degrees), FieldType(static_cast<int64_t>(value)));
+        }
+
+        return result;
+    }
+
+private:
+    struct Prime_ {
+        uint32_t value;
+        uint32_t root;
+    };
+
+    static constexpr std::array<Prime_, 3> kPrimes = {{
+        {998244353, 3},
+        {167772161, 3},
+        {469762049, 3}
+    }};
+
+    struct Layout_ {
+        // Exponent of the variable in the product is strictly less than its bound.
+        std::vector<size_t> bounds;
+        size_t productLength;
+    };
+
+    template<typename TermMap>
+    static std::vector<uint64_t> MaxDegrees_(const TermMap &terms) {
+        std::vector<uint64_t> maxDegrees;
+        for (const auto &[monomial, coefficient] : terms) {
+            if (maxDegrees.size() < monomial.GetAmountOfVariables()) {
+                maxDegrees.resize(monomial.GetAmountOfVariables());
+            }
+            for (IndexType variableIndex = 0; variableIndex < monomial.GetAmountOfVariables(); ++variableIndex) {
+                maxDegrees[variableIndex] = std::max(maxDegrees[variableIndex],
+                                                     static_cast<uint64_t>(monomial.GetDegree(variableIndex)));
+            }
+        }
+
+        return maxDegrees;
+    }
+
+    template<typename TermMap>
+    static std::optional<Layout_> ComputeLayout_(const TermMap &lhs, const TermMap &rhs) {
+        auto lhsDegrees = MaxDegrees_(lhs);
+        auto rhsDegrees = MaxDegrees_(rhs);
+        lhsDegrees.resize(std::max(lhsDegrees.size(), rhsDegrees.size()));
+        rhsDegrees.resize(lhsDegrees.size());
+
+        Layout_ layout{{}, 1};
+        for (IndexType variableIndex = 0; variableIndex < lhsDegrees.size(); ++variableIndex) {
+            uint64_t bound = lhsDegrees[variableIndex] + rhsDegrees[variableIndex] + 1;
+            if (bound > kMaxTransformLength || layout.productLength * bound > kMaxTransformLength) {
+                return std::nullopt;
+            }
+            layout.bounds.push_back(bound);
+            layout.productLength *= bound;
+        }
+
+        return layout;
+    }
+
+    static size_t TransformLength_(size_t productLength) {
+        size_t length = 1;
+        while (length < productLength) {
+            length <<= 1;
+        }
+
+        return length;
+    }
+
+    template<typename TermMap>
+    static std::vector<uint32_t> Pack_(const TermMap &terms, const Layout_ &layout) {
+        std::vector<uint32_t> values(layout.productLength);
+        for (const auto &[monomial, coefficient] : terms) {
+            size_t index = 0, stride = 1;
+            for (IndexType variableIndex = 0; variableIndex < layout.bounds.size(); ++variableIndex) {
+                index += static_cast<uint64_t>(monomial.GetDegree(variableIndex)) * stride;
+                stride *= layout.bounds[variableIndex];
+            }
+            values[index] = static_cast<uint32_t>(coefficient.GetValue());
+        }
+
+        return values;
+    }
+
+    static uint32_t PowMod_(uint64_t base, uint64_t exponent, uint32_t modulus) {
+        uint64_t result = 1;
+        base %= modulus;
+        while (exponent != 0) {
+            if (exponent & 1) {
+                result = result * base % modulus;
+            }
+            base = base * base % modulus;
+            exponent >>= 1;
+        }
+
+        return static_cast<uint32_t>(result);
+    }
+
+    static void Transform_(std::vector<uint32_t> &values, const Prime_ &prime, bool isInverse) {
+        const size_t length = values.size();
+        const uint32_t modulus = prime.value;
+
+        for (size_t i = 1, j = 0; i < length; ++i) {
+            size_t bit = length >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(values[i], values[j]);
+            }
+        }
+
+        for (size_t half = 1; half < length; half <<= 1) {
+            uint32_t step = PowMod_(prime.root, (modulus - 1) / (2 * half), modulus);
+            if (isInverse) {
+                step = PowMod_(step, modulus - 2, modulus);
+            }
+
+            std::vector<uint32_t> roots(half);
+            roots[0] = 1;
+            for (size_t k = 1; k < half; ++k) {
+                roots[k] = static_cast<uint32_t>(static_cast<uint64_t>(roots[k - 1]) * step % modulus);
+            }
+
+            for (size_t start = 0; start < length; start += 2 * half) {
+                for (size_t k = 0; k < half; ++k) {
+                    uint32_t u = values[start + k];
+                    uint32_t v = static_cast<uint32_t>(static_cast<uint64_t>(values[start + k + half]) * roots[k] % modulus);
+                    values[start + k] = u + v >= modulus ? u + v - modulus : u + v;
+                    values[start + k + half] = u >= v ? u - v : u + modulus - v;
+                }
+            }
+        }
+
+        if (isInverse) {
+            uint64_t lengthInverse = PowMod_(length, modulus - 2, modulus);
+            for (auto &value : values) {
+                value = static_cast<uint32_t>(value * lengthInverse % modulus);
+            }
+        }
+    }
+
+    static std::vector<uint32_t> Convolve_(const std::vector<uint32_t> &lhs, const std::vector<uint32_t> &rhs,
+                                           size_t length, const Prime_ &prime) {
+        std::vector<uint32_t> lhsTransform(length), rhsTransform(length);
+        for (size_t index = 0; index < lhs.size(); ++index) {
+            lhsTransform[index] = lhs[index] % prime.value;
+            rhsTransform[index] = rhs[index] % prime.value;
+        }
+
+        Transform_(lhsTransform, prime, false);
+        Transform_(rhsTransform, prime, false);
+        for (size_t index = 0; index < length; ++index) {
+            lhsTransform[index] = static_cast<uint32_t>(
+                    static_cast<uint64_t>(lhsTransform[index]) * rhsTransform[index] % prime.value);
+        }
+        Transform_(lhsTransform, prime, true);
+
+        return lhsTransform;
+    }
+
+    // Garner's algorithm: the exact coefficient is below the product of the three primes,
+    // its mixed radix digits are found first and then folded modulo the target modulus.
+    static uint64_t Reconstruct_(uint32_t r0, uint32_t r1, uint32_t r2, uint64_t modulus) {
+        const uint64_t p0 = kPrimes[0].value, p1 = kPrimes[1].value, p2 = kPrimes[2].value;
+        static const uint64_t p0InverseModP1 = PowMod_(p0, p1 - 2, p1);
+        static const uint64_t p01InverseModP2 = PowMod_(p0 * p1 % p2, p2 - 2, p2);
+
+        uint64_t d0 = r0;
+        uint64_t d1 = (r1 + p1 - d0 % p1) % p1 * p0InverseModP1 % p1;
+        uint64_t partial = (d0 + d1 * p0) % p2;
+        uint64_t d2 = (r2 + p2 - partial) % p2 * p01InverseModP2 % p2;
+
+        uint64_t result = d0 % modulus;
+        result = (result + d1 * (p0 % modulus)) % modulus;
+        result = (result + d2 * (p0 * p1 % modulus) % modulus) % modulus;
+
+        return result;
+    }
+};
+
+} // namespace GB
@@ -0,0 +1,483 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "division.h"
+#include "cofactors.h"
+#include "modular.h"
+
+#include <cstdint>
+
+#include <map>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace GB {
+
+// Gröbner basis over Q by p-adic lifting instead of the Chinese remainder theorem over many primes.
+// The basis is computed once modulo p with a cofactor trace. For every element g the trace fixes
+// the supports: g = LM(g) + sum v_t t over the monomials t of g mod p, and g = sum h_i f_i with
+// h_i supported on the monomials of the cofactors mod p. Comparing the coefficients of both sides
+// gives an integer linear system whose solution modulo p is already known. A non-singular square
+// part of it is inverted once modulo p, and Dixon's iteration x = x_0 + x_1 p + x_2 p^2 + ...
+// lifts the solution with one matrix-vector product per digit, all in fixed-size integers.
+// The rationals are recovered by rational reconstruction as soon as p^k is large enough,
+// and the result is certified: every h_i is checked exactly, then all S-pairs and generators
+// are reduced over Q. A prime dividing a denominator, a rank drop modulo p or coefficients
+// outside of 64-bit integers make Lift return nothing.
+template<SuitableOrder<Monomial> MonomialOrder>
+class PAdicLifting {
+public:
+    static constexpr uint32_t kPrime = 2147483647;
+    // p^4 < 2^124, so the lifted residues fit into 128 bits and the reconstructed
+    // numerators and denominators fit into 62 bits.
+    static constexpr size_t kMaxPrecision = 4;
+
+    using ModularField = Modular<kPrime>;
+    using RationalPolynomial = Polynomial<Rational<>, MonomialOrder>;
+    using ModularPolynomial = Polynomial<ModularField, MonomialOrder>;
+    using IndexType = size_t;
+
+    explicit PAdicLifting(const PolynomialSet<Rational<>, MonomialOrder> &generators) {
+        for (const auto &generator : generators) {
+            if (!RationalPolynomial::IsZero(generator)) {
+                generators_.push_back(generator);
+            }
+        }
+    }
+
+    std::optional<PolynomialSet<Rational<>, MonomialOrder>> Lift() {
+        precision_ = 0;
+
+        PolynomialSet<ModularField, MonomialOrder> modularSet;
+        std::map<ModularPolynomial, IndexType, Less<ModularField>> generatorByImage;
+        std::vector<RationalPolynomial> integralGenerators;
+        for (IndexType index = 0; index < generators_.size(); ++index) {
+            auto image = ToModular_(generators_[index]);
+            auto integral = ClearDenominators_(generators_[index]);
+            if (!image.has_value() || !integral.has_value()) {
+                return std::nullopt;
+            }
+            generatorByImage.emplace(*image, index);
+            modularSet.insert(std::move(*image));
+            integralGenerators.push_back(std::move(*integral));
+        }
+
+        CofactorTracker<ModularField, MonomialOrder> tracker;
+        BuhbergerAlgorithm(modularSet, tracker);
+
+        std::vector<IndexType> rationalIndex(tracker.GetAmountOfGenerators());
+        for (IndexType index = 0; index < rationalIndex.size(); ++index) {
+            rationalIndex[index] = generatorByImage.at(tracker.GetElement(index));
+        }
+
+        PolynomialSet<Rational<>, MonomialOrder> result;
+        for (const auto &element : modularSet) {
+            auto cofactors = tracker.GetCofactors(element);
+
+            std::vector<std::set<Monomial, MonomialOrder>> supports(generators_.size());
+            for (IndexType index = 0; index < cofactors.size(); ++index) {
+                for (const auto &[monomial, coefficient] : cofactors[index]) {
+                    supports[rationalIndex[index]].insert(monomial);
+                }
+            }
+
+            auto lifted = LiftElement_(element, supports, integralGenerators);
+            if (!lifted.has_value()) {
+                return std::nullopt;
+            }
+            result.insert(std::move(*lifted));
+        }
+
+        if (!IsGroebnerBasisOf_(result)) {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    // Amount of p-adic digits the last Lift call needed for the hardest basis element.
+    [[nodiscard]] size_t GetPrecision() const noexcept {
+        return precision_;
+    }
+
+private:
+    using SignedWide_ = __int128;
+    using UnsignedWide_ = unsigned __int128;
+
+    // Sparse integer column of the linear system.
+    using Column_ = std::vector<std::pair<IndexType, int64_t>>;
+
+    std::optional<RationalPolynomial> LiftElement_(
+            const ModularPolynomial &element,
+            const std::vector<std::set<Monomial, MonomialOrder>> &supports,
+            const std::vector<RationalPolynomial> &integralGenerators)
+    {
+        // Columns: the unknowns of every h_i, then the tail coefficients of g. Rows: monomials.
+        std::map<Monomial, IndexType, MonomialOrder> rowByMonomial;
+        auto rowOf = [&] (const Monomial &monomial) {
+            return rowByMonomial.emplace(monomial, rowByMonomial.size()).first->second;
+        };
+
+        std::vector<Column_> columns;
+        std::vector<std::pair<IndexType, Monomial>> cofactorUnknowns;
+        for (IndexType generator = 0; generator < supports.size(); ++generator) {
+            for (const auto &monomial : supports[generator]) {
+                Column_ column;
+                for (const auto &[generatorMonomial, coefficient] : integralGenerators[generator]) {
+                    column.emplace_back(rowOf(monomial * generatorMonomial), coefficient.GetNumerator());
+                }
+                columns.push_back(std::move(column));
+                cofactorUnknowns.emplace_back(generator, monomial);
+            }
+        }
+
+        const auto &leadingMonomial = element.GetLeadingTerm().first;
+        std::vector<Monomial> tailMonomials;
+        for (auto iter = std::next(element.begin()); iter != element.end(); ++iter) {
+            columns.push_back({{rowOf(iter->first), -1}});
+            tailMonomials.push_back(iter->first);
+        }
+
+        IndexType leadingRow = rowOf(leadingMonomial);
+        std::vector<int64_t> rightSide(rowByMonomial.size());
+        rightSide[leadingRow] = 1;
+
+        auto [pivotRows, pivotColumns] = FindNonSingularPart_(columns, rowByMonomial.size());
+        auto inverse = InvertModular_(columns, pivotRows, pivotColumns);
+        if (!inverse.has_value()) {
+            return std::nullopt;
+        }
+
+        const IndexType size = pivotColumns.size();
+        std::vector<IndexType> positionOfRow(rowByMonomial.size(), size);
+        for (IndexType position = 0; position < size; ++position) {
+            positionOfRow[pivotRows[position]] = position;
+        }
+
+        // Dixon: residual_{j+1} = (residual_j - A x_j) / p is exact, x_j = A^{-1} residual_j mod p.
+        std::vector<SignedWide_> residual(size);
+        for (IndexType position = 0; position < size; ++position) {
+            residual[position] = rightSide[pivotRows[position]];
+        }
+        std::vector<UnsignedWide_> solution(size);
+        UnsignedWide_ modulus = 1;
+
+        for (size_t precision = 1; precision <= kMaxPrecision; ++precision) {
+            std::vector<ModularField> digits(size);
+            for (IndexType row = 0; row < size; ++row) {
+                ModularField digit = 0;
+                for (IndexType position = 0; position < size; ++position) {
+                    digit += (*inverse)[row][position] * ModularField(static_cast<int64_t>(residual[position] % kPrime));
+                }
+                digits[row] = digit;
+            }
+
+            for (IndexType position = 0; position < size; ++position) {
+                solution[position] += modulus * digits[position].GetValue();
+                for (const auto &[row, value] : columns[pivotColumns[position]]) {
+                    if (positionOfRow[row] != size) {
+                        residual[positionOfRow[row]] -= static_cast<SignedWide_>(value) * digits[position].GetValue();
+                    }
+                }
+            }
+            for (auto &value : residual) {
+                assert(value % kPrime == 0);
+                value /= kPrime;
+            }
+            modulus *= kPrime;
+
+            std::vector<Rational<>> values(columns.size());
+            bool isReconstructed = true;
+            for (IndexType position = 0; position < size && isReconstructed; ++position) {
+                auto value = ReconstructRational_(solution[position], modulus);
+                isReconstructed = value.has_value();
+                if (isReconstructed) {
+                    values[pivotColumns[position]] = *value;
+                }
+            }
+            if (!isReconstructed) {
+                continue;
+            }
+
+            if (!IsExactSolution_(columns, rightSide, pivotColumns, values)) {
+                continue;
+            }
+
+            RationalPolynomial candidate(typename RationalPolynomial::Term{leadingMonomial, 1});
+            for (IndexType index = 0; index < tailMonomials.size(); ++index) {
+                candidate += RationalPolynomial(typename RationalPolynomial::Term{
+                        tailMonomials[index], values[cofactorUnknowns.size() + index]});
+            }
+
+            precision_ = std::max(precision_, precision);
+            return candidate;
+        }
+
+        return std::nullopt;
+    }
+
+    // Checks sum h_i f_i = g exactly: with D the common denominator of the unknowns,
+    // sum_j A_ij (D x_j) = D b_i in 128-bit integers, an overflow counts as a failure.
+    static bool IsExactSolution_(
+            const std::vector<Column_> &columns,
+            const std::vector<int64_t> &rightSide,
+            const std::vector<IndexType> &pivotColumns,
+            const std::vector<Rational<>> &values)
+    {
+        int64_t commonDenominator = 1;
+        for (auto column : pivotColumns) {
+            int64_t denominator = values[column].GetDenominator();
+            if (__builtin_mul_overflow(commonDenominator / std::gcd(commonDenominator, denominator), denominator,
+                                       &commonDenominator)) {
+                return false;
+            }
+        }
+
+        std::vector<SignedWide_> sums(rightSide.size());
+        for (auto column : pivotColumns) {
+            int64_t scaled;
+            if (__builtin_mul_overflow(values[column].GetNumerator(), commonDenominator / values[column].GetDenominator(),
+                                       &scaled)) {
+                return false;
+            }
+
+            for (const auto &[row, value] : columns[column]) {
+                SignedWide_ product = static_cast<SignedWide_>(value) * scaled;
+                if (__builtin_add_overflow(sums[row], product, &sums[row])) {
+                    return false;
+                }
+            }
+        }
+
+        for (IndexType row = 0; row < rightSide.size(); ++row) {
+            if (sums[row] != static_cast<SignedWide_>(rightSide[row]) * commonDenominator) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Row and column indices of a largest non-singular square submatrix modulo p:
+    // columns by elimination on the columns, then rows by elimination on their restriction.
+    static std::pair<std::vector<IndexType>, std::vector<IndexType>> FindNonSingularPart_(
+            const std::vector<Column_> &columns, IndexType amountOfRows)
+    {
+        auto eliminate = [] (std::vector<std::vector<ModularField>> vectors) {
+            std::vector<IndexType> independent;
+            std::vector<std::vector<ModularField>> basis;
+            std::vector<IndexType> basisPivots;
+            for (IndexType index = 0; index < vectors.size(); ++index) {
+                auto &vector = vectors[index];
+                for (IndexType position = 0; position < basis.size(); ++position) {
+                    if (auto factor = vector[basisPivots[position]]; factor != ModularField(0)) {
+                        for (IndexType entry = 0; entry < vector.size(); ++entry) {
+                            vector[entry] -= factor * basis[position][entry];
+                        }
+                    }
+                }
+
+                auto pivot = std::find_if(vector.begin(), vector.end(), [] (const auto &value) {
+                    return value != ModularField(0);
+                });
+                if (pivot == vector.end()) {
+                    continue;
+                }
+
+                auto inverse = pivot->GetInverted();
+                for (auto &value : vector) {
+                    value *= inverse;
+                }
+                basisPivots.push_back(pivot - vector.begin());
+                basis.push_back(std::move(vector));
+                independent.push_back(index);
+            }
+
+            return independent;
+        };
+
+        std::vector<std::vector<ModularField>> denseColumns(columns.size(), std::vector<ModularField>(amountOfRows));
+        for (IndexType column = 0; column < columns.size(); ++column) {
+            for (const auto &[row, value] : columns[column]) {
+                denseColumns[column][row] += ModularField(value);
+            }
+        }
+        auto pivotColumns = eliminate(denseColumns);
+
+        std::vector<std::vector<ModularField>> restrictedRows(amountOfRows, std::vector<ModularField>(pivotColumns.size()));
+        for (IndexType position = 0; position < pivotColumns.size(); ++position) {
+            for (IndexType row = 0; row < amountOfRows; ++row) {
+                restrictedRows[row][position] = denseColumns[pivotColumns[position]][row];
+            }
+        }
+        auto pivotRows = eliminate(std::move(restrictedRows));
+
+        return {std::move(pivotRows), std::move(pivotColumns)};
+    }
+
+    // Gauss-Jordan inverse of the chosen square part modulo p.
+    static std::optional<std::vector<std::vector<ModularField>>> InvertModular_(
+            const std::vector<Column_> &columns,
+            const std::vector<IndexType> &pivotRows,
+            const std::vector<IndexType> &pivotColumns)
+    {
+        const IndexType size = pivotColumns.size();
+        if (pivotRows.size() != size) {
+            return std::nullopt;
+        }
+
+        std::map<IndexType, IndexType> positionOfRow;
+        for (IndexType position = 0; position < size; ++position) {
+            positionOfRow[pivotRows[position]] = position;
+        }
+
+        std::vector<std::vector<ModularField>> matrix(size, std::vector<ModularField>(2 * size));
+        for (IndexType position = 0; position < size; ++position) {
+            for (const auto &[row, value] : columns[pivotColumns[position]]) {
+                if (auto found = positionOfRow.find(row); found != positionOfRow.end()) {
+                    matrix[found->second][position] += ModularField(value);
+                }
+            }
+            matrix[position][size + position] = 1;
+        }
+
+        for (IndexType column = 0; column < size; ++column) {
+            auto pivot = column;
+            while (pivot < size && matrix[pivot][column] == ModularField(0)) {
+                ++pivot;
+            }
+            if (pivot == size) {
+                return std::nullopt;
+            }
+            std::swap(matrix[pivot], matrix[column]);
+
+            auto inverse = matrix[column][column].GetInverted();
+            for (auto &value : matrix[column]) {
+                value *= inverse;
+            }
+            for (IndexType row = 0; row < size; ++row) {
+                if (auto factor = matrix[row][column]; row != column && factor != ModularField(0)) {
+                    for (IndexType entry = column; entry < 2 * size; ++entry) {
+                        matrix[row][entry] -= factor * matrix[column][entry];
+                    }
+                }
+            }
+        }
+
+        for (auto &row : matrix) {
+            row.erase(row.begin(), row.begin() + size);
+        }
+
+        return matrix;
+    }
+
+    // Wang's rational reconstruction: n / d = value mod modulus with |n|, d <= sqrt(modulus / 2).
+    static std::optional<Rational<>> ReconstructRational_(UnsignedWide_ value, UnsignedWide_ modulus) {
+        UnsignedWide_ bound = SquareRoot_(modulus / 2);
+
+        UnsignedWide_ previousRemainder = modulus, remainder = value;
+        SignedWide_ previousCoefficient = 0, coefficient = 1;
+        while (remainder > bound) {
+            UnsignedWide_ quotient = previousRemainder / remainder;
+            previousRemainder = std::exchange(remainder, previousRemainder - quotient * remainder);
+            previousCoefficient = std::exchange(coefficient, previousCoefficient - static_cast<SignedWide_>(quotient) * coefficient);
+        }
+
+        UnsignedWide_ denominator = coefficient < 0 ? -coefficient : coefficient;
+        if (denominator == 0 || denominator > bound || remainder > static_cast<UnsignedWide_>(INT64_MAX) ||
+            denominator > static_cast<UnsignedWide_>(INT64_MAX)) {
+            return std::nullopt;
+        }
+
+        auto numerator = static_cast<int64_t>(remainder);
+        return Rational<>(coefficient < 0 ? -numerator : numerator, static_cast<int64_t>(denominator));
+    }
+
+    static UnsignedWide_ SquareRoot_(UnsignedWide_ value) {
+        UnsignedWide_ low = 0, high = UnsignedWide_(1) << 64;
+        while (high - low > 1) {
+            UnsignedWide_ middle = (low + high) / 2;
+            (middle * middle <= value ? low : high) = middle;
+        }
+
+        return low;
+    }
+
+    static std::optional<ModularPolynomial> ToModular_(const RationalPolynomial &polynomial) {
+        ModularPolynomial result;
+        for (const auto &[monomial, coefficient] : polynomial) {
+            ModularField denominator(coefficient.GetDenominator());
+            if (denominator == ModularField(0)) {
+                return std::nullopt;
+            }
+            result.PushBackTerm(monomial, ModularField(coefficient.GetNumerator()) / denominator);
+        }
+
+        return result;
+    }
+
+    static std::optional<RationalPolynomial> ClearDenominators_(const RationalPolynomial &polynomial) {
+        int64_t multiplier = 1;
+        for (const auto &[monomial, coefficient] : polynomial) {
+            int64_t denominator = coefficient.GetDenominator();
+            if (__builtin_mul_overflow(multiplier / std::gcd(multiplier, denominator), denominator, &multiplier)) {
+                return std::nullopt;
+            }
+        }
+
+        RationalPolynomial result;
+        for (const auto &[monomial, coefficient] : polynomial) {
+            int64_t numerator;
+            if (__builtin_mul_overflow(coefficient.GetNumerator(), multiplier / coefficient.GetDenominator(), &numerator)) {
+                return std::nullopt;
+            }
+            result.PushBackTerm(monomial, numerator);
+        }
+
+        return result;
+    }
+
+    // The elements are in the ideal by construction, so this checks the generators
+    // reduce to zero and the S-pairs do too.
+    bool IsGroebnerBasisOf_(const PolynomialSet<Rational<>, MonomialOrder> &basis) const {
+        for (const auto &generator : generators_) {
+            if (!RationalPolynomial::IsZero(HeapReduction(generator, basis))) {
+                return false;
+            }
+        }
+
+        for (auto first = basis.begin(); first != basis.end(); ++first) {
+            for (auto second = basis.begin(); second != first; ++second) {
+                if (!CheckLeadingTermsCoprime(*first, *second) &&
+                    !RationalPolynomial::IsZero(HeapReduction(SPolynomialStream(*first, *second), basis))) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<RationalPolynomial> generators_;
+    size_t precision_ = 0;
+};
+
+// Lifts the basis modulo one prime when possible and falls back to BuhbergerAlgorithm otherwise,
+// the result is the reduced Gröbner basis either way.
+template<SuitableOrder<Monomial> MonomialOrder>
+void PAdicBuhbergerAlgorithm(PolynomialSet<Rational<>, MonomialOrder> &set) {
+    if (auto lifted = PAdicLifting<MonomialOrder>(set).Lift(); lifted.has_value()) {
+        set = std::move(*lifted);
+        return;
+    }
+
+    BuhbergerAlgorithm(set);
+}
+
+} // namespace GB
@@ -1,6 +1,14 @@
 #include "test.h"
+#include "benchmark.h"
+
+#include <string_view>
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && std::string_view(argv[1]) == "--bench") {
+        GB::RunBenchmarks();
+        return 0;
+    }
 
-int main() {
     GB::TestAll();
     return 0;
 }
@@ -0,0 +1,537 @@
+#pragma once
+
+#include "concepts.h"
+
+#include <cstdint>
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+
+namespace GB {
+
+template<uint32_t Modulus>
+class Modular {
+// The following class invariant is used:
+// value is the canonical representative, 0 <= value < Modulus.
+
+static_assert(Modulus > 1 && Modulus < (1u << 31), "Modulus has to fit into 31 bits");
+
+public:
+    Modular() noexcept : value_(0) {
+    }
+
+    Modular(int64_t value) noexcept : value_(Normalize_(value)) {
+    }
+
+    static constexpr uint32_t GetModulus() noexcept {
+        return Modulus;
+    }
+
+    [[nodiscard]] uint32_t GetValue() const noexcept {
+        return value_;
+    }
+
+    // Modulus is expected to be prime, so every non-zero element is invertible.
+    void Invert() {
+        if (value_ == 0) {
+            throw std::overflow_error("Divide by zero exception");
+        }
+        *this = Pow(*this, Modulus - 2);
+    }
+
+    Modular GetInverted() const {
+        Modular result = *this;
+
+        result.Invert();
+        return result;
+    }
+
+    static Modular Pow(Modular base, uint64_t exponent) noexcept {
+        Modular result = 1;
+        while (exponent != 0) {
+            if (exponent & 1) {
+                result *= base;
+            }
+            base *= base;
+            exponent >>= 1;
+        }
+
+        return result;
+    }
+
+    Modular operator+() const noexcept {
+        Modular result = *this;
+
+        return result;
+    }
+
+    Modular operator-() const noexcept {
+        Modular result;
+        result.value_ = value_ == 0 ? 0 : Modulus - value_;
+
+        return result;
+    }
+
+    Modular &operator+=(const Modular &other) noexcept {
+        value_ += other.value_;
+        if (value_ >= Modulus) {
+            value_ -= Modulus;
+        }
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    Modular &operator-=(const Modular &other) noexcept {
+        value_ = value_ >= other.value_ ? value_ - other.value_ : value_ + Modulus - other.value_;
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    Modular &operator*=(const Modular &other) noexcept {
+        value_ = static_cast<uint32_t>(static_cast<uint64_t>(value_) * other.value_ % Modulus);
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    Modular &operator/=(const Modular &other) {
+        *this *= other.GetInverted();
+
+        return *this;
+    }
+
+    friend Modular operator+(const Modular &lhs, const Modular &rhs) noexcept {
+        Modular result = lhs;
+        result += rhs;
+
+        return result;
+    }
+
+    friend Modular operator-(const Modular &lhs, const Modular &rhs) noexcept {
+        Modular result = lhs;
+        result -= rhs;
+
+        return result;
+    }
+
+    friend Modular operator*(const Modular &lhs, const Modular &rhs) noexcept {
+        Modular result = lhs;
+        result *= rhs;
+
+        return result;
+    }
+
+    friend Modular operator/(const Modular &lhs, const Modular &rhs) {
+        Modular result = lhs;
+        result /= rhs;
+
+        return result;
+    }
+
+    friend bool operator==(const Modular &lhs, const Modular &rhs) noexcept {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend bool operator!=(const Modular &lhs, const Modular &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    // Residues are not ordered, this only compares representatives so that
+    // elements can be printed and stored in ordered containers.
+    friend bool operator<(const Modular &lhs, const Modular &rhs) noexcept {
+        return lhs.value_ < rhs.value_;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const Modular &other) {
+        out << other.value_;
+        return out;
+    }
+
+private:
+    static uint32_t Normalize_(int64_t value) noexcept {
+        int64_t remainder = value % static_cast<int64_t>(Modulus);
+        return static_cast<uint32_t>(remainder < 0 ? remainder + Modulus : remainder);
+    }
+
+    void CheckInvariants_() const noexcept {
+        assert(value_ < Modulus);
+    }
+
+    uint32_t value_;
+};
+
+// There are no negative residues, so the absolute value is the element itself.
+template<uint32_t Modulus>
+Modular<Modulus> abs(const Modular<Modulus> &other) {
+    return other;
+}
+
+// Prime field for moduli up to 2^63, a multi-modular computation needs half as many of them
+// as of the word-size ones. Elements are kept in Montgomery form x R mod p with R = 2^64:
+// the product of two such elements is a 128-bit number and the Montgomery reduction
+// brings it back with two 64-bit multiplications and no division.
+template<uint64_t Modulus>
+class LargeModular {
+// The following class invariant is used:
+// value is the Montgomery form of the element, 0 <= value < Modulus.
+
+static_assert(Modulus > 2 && Modulus % 2 == 1 && Modulus < (uint64_t(1) << 63), "Modulus has to be odd and fit into 63 bits");
+
+public:
+    LargeModular() noexcept : value_(0) {
+    }
+
+    LargeModular(int64_t value) noexcept : value_(Reduce_(static_cast<unsigned __int128>(Normalize_(value)) * kRSquared_)) {
+    }
+
+    static constexpr uint64_t GetModulus() noexcept {
+        return Modulus;
+    }
+
+    [[nodiscard]] uint64_t GetValue() const noexcept {
+        return Reduce_(value_);
+    }
+
+    // Modulus is expected to be prime, so every non-zero element is invertible.
+    void Invert() {
+        if (value_ == 0) {
+            throw std::overflow_error("Divide by zero exception");
+        }
+        *this = Pow(*this, Modulus - 2);
+    }
+
+    LargeModular GetInverted() const {
+        LargeModular result = *this;
+
+        result.Invert();
+        return result;
+    }
+
+    static LargeModular Pow(LargeModular base, uint64_t exponent) noexcept {
+        LargeModular result = 1;
+        while (exponent != 0) {
+            if (exponent & 1) {
+                result *= base;
+            }
+            base *= base;
+            exponent >>= 1;
+        }
+
+        return result;
+    }
+
+    LargeModular operator+() const noexcept {
+        LargeModular result = *this;
+
+        return result;
+    }
+
+    LargeModular operator-() const noexcept {
+        LargeModular result;
+        result.value_ = value_ == 0 ? 0 : Modulus - value_;
+
+        return result;
+    }
+
+    LargeModular &operator+=(const LargeModular &other) noexcept {
+        value_ += other.value_;
+        if (value_ >= Modulus) {
+            value_ -= Modulus;
+        }
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    LargeModular &operator-=(const LargeModular &other) noexcept {
+        value_ = value_ >= other.value_ ? value_ - other.value_ : value_ + Modulus - other.value_;
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    LargeModular &operator*=(const LargeModular &other) noexcept {
+        value_ = Reduce_(static_cast<unsigned __int128>(value_) * other.value_);
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    LargeModular &operator/=(const LargeModular &other) {
+        *this *= other.GetInverted();
+
+        return *this;
+    }
+
+    friend LargeModular operator+(const LargeModular &lhs, const LargeModular &rhs) noexcept {
+        LargeModular result = lhs;
+        result += rhs;
+
+        return result;
+    }
+
+    friend LargeModular operator-(const LargeModular &lhs, const LargeModular &rhs) noexcept {
+        LargeModular result = lhs;
+        result -= rhs;
+
+        return result;
+    }
+
+    friend LargeModular operator*(const LargeModular &lhs, const LargeModular &rhs) noexcept {
+        LargeModular result = lhs;
+        result *= rhs;
+
+        return result;
+    }
+
+    friend LargeModular operator/(const LargeModular &lhs, const LargeModular &rhs) {
+        LargeModular result = lhs;
+        result /= rhs;
+
+        return result;
+    }
+
+    friend bool operator==(const LargeModular &lhs, const LargeModular &rhs) noexcept {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend bool operator!=(const LargeModular &lhs, const LargeModular &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const LargeModular &lhs, const LargeModular &rhs) noexcept {
+        return lhs.GetValue() < rhs.GetValue();
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const LargeModular &other) {
+        out << other.GetValue();
+        return out;
+    }
+
+private:
+    // -Modulus^{-1} mod 2^64 by Newton's iteration, each step doubles the amount of correct bits.
+    static constexpr uint64_t ComputeNegatedInverse_() noexcept {
+        uint64_t inverse = Modulus;
+        for (int step = 0; step < 5; ++step) {
+            inverse *= 2 - Modulus * inverse;
+        }
+
+        return -inverse;
+    }
+
+    static constexpr uint64_t kNegatedInverse_ = ComputeNegatedInverse_();
+    static constexpr uint64_t kR_ = -Modulus % Modulus;
+    static constexpr uint64_t kRSquared_ = static_cast<uint64_t>(static_cast<unsigned __int128>(kR_) * kR_ % Modulus);
+
+    // Montgomery reduction, returns value R^{-1} mod Modulus for value < Modulus 2^64.
+    static uint64_t Reduce_(unsigned __int128 value) noexcept {
+        uint64_t factor = static_cast<uint64_t>(value) * kNegatedInverse_;
+        auto result = static_cast<uint64_t>((value + static_cast<unsigned __int128>(factor) * Modulus) >> 64);
+
+        return result >= Modulus ? result - Modulus : result;
+    }
+
+    static uint64_t Normalize_(int64_t value) noexcept {
+        if (value >= 0) {
+            return static_cast<uint64_t>(value) % Modulus;
+        }
+
+        uint64_t remainder = (0 - static_cast<uint64_t>(value)) % Modulus;
+        return remainder == 0 ? 0 : Modulus - remainder;
+    }
+
+    void CheckInvariants_() const noexcept {
+        assert(value_ < Modulus);
+    }
+
+    uint64_t value_;
+};
+
+template<uint64_t Modulus>
+LargeModular<Modulus> abs(const LargeModular<Modulus> &other) {
+    return other;
+}
+
+// Prime field whose modulus is chosen at run time, e.g. a random prime. The modulus is
+// a thread-local setting made by ModulusScope, so threads may work modulo different primes
+// at once; elements must not outlive the scope or cross threads. There is no static
+// GetModulus, the modulus is not a constant, so it never takes the Kronecker path.
+class RuntimeModular {
+// The following class invariant is used:
+// value is the canonical representative, 0 <= value < modulus of the current thread.
+
+public:
+    class ModulusScope {
+    public:
+        explicit ModulusScope(uint32_t modulus) : previous_(modulus_) {
+            if (modulus < 2 || modulus >= (1u << 31)) {
+                throw std::invalid_argument("Modulus has to fit into 31 bits");
+            }
+            modulus_ = modulus;
+        }
+
+        ModulusScope(const ModulusScope &) = delete;
+        ModulusScope &operator=(const ModulusScope &) = delete;
+
+        ~ModulusScope() {
+            modulus_ = previous_;
+        }
+
+    private:
+        uint32_t previous_;
+    };
+
+    RuntimeModular() noexcept : value_(0) {
+    }
+
+    RuntimeModular(int64_t value) noexcept : value_(Normalize_(value)) {
+    }
+
+    static uint32_t GetCurrentModulus() noexcept {
+        return modulus_;
+    }
+
+    [[nodiscard]] uint32_t GetValue() const noexcept {
+        return value_;
+    }
+
+    // The modulus is expected to be prime, so every non-zero element is invertible.
+    void Invert() {
+        if (value_ == 0) {
+            throw std::overflow_error("Divide by zero exception");
+        }
+        *this = Pow(*this, modulus_ - 2);
+    }
+
+    RuntimeModular GetInverted() const {
+        RuntimeModular result = *this;
+
+        result.Invert();
+        return result;
+    }
+
+    static RuntimeModular Pow(RuntimeModular base, uint64_t exponent) noexcept {
+        RuntimeModular result = 1;
+        while (exponent != 0) {
+            if (exponent & 1) {
+                result *= base;
+            }
+            base *= base;
+            exponent >>= 1;
+        }
+
+        return result;
+    }
+
+    RuntimeModular operator+() const noexcept {
+        RuntimeModular result = *this;
+
+        return result;
+    }
+
+    RuntimeModular operator-() const noexcept {
+        RuntimeModular result;
+        result.value_ = value_ == 0 ? 0 : modulus_ - value_;
+
+        return result;
+    }
+
+    RuntimeModular &operator+=(const RuntimeModular &other) noexcept {
+        value_ += other.value_;
+        if (value_ >= modulus_) {
+            value_ -= modulus_;
+        }
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    RuntimeModular &operator-=(const RuntimeModular &other) noexcept {
+        value_ = value_ >= other.value_ ? value_ - other.value_ : value_ + modulus_ - other.value_;
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    RuntimeModular &operator*=(const RuntimeModular &other) noexcept {
+        value_ = static_cast<uint32_t>(static_cast<uint64_t>(value_) * other.value_ % modulus_);
+
+        CheckInvariants_();
+        return *this;
+    }
+
+    RuntimeModular &operator/=(const RuntimeModular &other) {
+        *this *= other.GetInverted();
+
+        return *this;
+    }
+
+    friend RuntimeModular operator+(const RuntimeModular &lhs, const RuntimeModular &rhs) noexcept {
+        RuntimeModular result = lhs;
+        result += rhs;
+
+        return result;
+    }
+
+    friend RuntimeModular operator-(const RuntimeModular &lhs, const RuntimeModular &rhs) noexcept {
+        RuntimeModular result = lhs;
+        result -= rhs;
+
+        return result;
+    }
+
+    friend RuntimeModular operator*(const RuntimeModular &lhs, const RuntimeModular &rhs) noexcept {
+        RuntimeModular result = lhs;
+        result *= rhs;
+
+        return result;
+    }
+
+    friend RuntimeModular operator/(const RuntimeModular &lhs, const RuntimeModular &rhs) {
+        RuntimeModular result = lhs;
+        result /= rhs;
+
+        return result;
+    }
+
+    friend bool operator==(const RuntimeModular &lhs, const RuntimeModular &rhs) noexcept {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend bool operator!=(const RuntimeModular &lhs, const RuntimeModular &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const RuntimeModular &lhs, const RuntimeModular &rhs) noexcept {
+        return lhs.value_ < rhs.value_;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const RuntimeModular &other) {
+        out << other.value_;
+        return out;
+    }
+
+private:
+    static uint32_t Normalize_(int64_t value) noexcept {
+        assert(modulus_ != 0);
+        int64_t remainder = value % static_cast<int64_t>(modulus_);
+        return static_cast<uint32_t>(remainder < 0 ? remainder + modulus_ : remainder);
+    }
+
+    void CheckInvariants_() const noexcept {
+        assert(value_ < modulus_);
+    }
+
+    static inline thread_local uint32_t modulus_ = 0;
+
+    uint32_t value_;
+};
+
+inline RuntimeModular abs(const RuntimeModular &other) {
+    return other;
+}
+
+} // namespace GB
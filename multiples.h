@@ -0,0 +1,243 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "division.h"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace GB {
+
+struct MultipleCacheStatistics {
+    size_t hits = 0;
+    // Lookups answered by a cached multiple u * g with u a proper divisor of the multiplier.
+    size_t simplifiedHits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+
+    [[nodiscard]] double GetHitRate() const noexcept {
+        size_t lookups = hits + simplifiedHits + misses;
+        return lookups == 0 ? 0 : static_cast<double>(hits + simplifiedHits) / static_cast<double>(lookups);
+    }
+};
+
+// Multiplication by a monomial keeps the order of terms, so the product is built by appending.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+Polynomial<FieldType, MonomialOrder> MultiplyByMonomial(
+        const Polynomial<FieldType, MonomialOrder> &polynomial,
+        const Monomial &multiplier)
+{
+    Polynomial<FieldType, MonomialOrder> result;
+    for (const auto &[monomial, coefficient] : polynomial) {
+        result.PushBackTerm(monomial * multiplier, coefficient);
+    }
+    return result;
+}
+
+// Bounded cache of products m * g of basis elements by monomials. Entries are found by the
+// leading monomial of g and checked against g itself, so they survive the rebuilding of the
+// basis between rounds as long as g does not change. With simplification (the Simplify of F4)
+// the tail of a stored product is reduced by the basis, and a product m * g may be answered
+// by (m / u) * p for a stored p = u * g with u dividing m. Both have the same leading term and
+// differ by an element of the ideal with smaller terms, which keeps S-pair criteria valid.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+class MonomialMultipleCache {
+public:
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using PolynomialSetType = PolynomialSet<FieldType, MonomialOrder>;
+
+    // The limit counts the terms of all stored products.
+    explicit MonomialMultipleCache(size_t maxTerms, bool isSimplifying = false)
+        : maxTerms_(maxTerms), isSimplifying_(isSimplifying)
+    {
+    }
+
+    // Returns m * g or, when simplifying, a polynomial with the same leading term equal to it modulo the basis.
+    PolynomialType Multiply(const PolynomialType &element, const Monomial &multiplier, const PolynomialSetType &basis) {
+        const auto leadingMonomial = element.GetLeadingTerm().first;
+        auto &elements = buckets_[leadingMonomial];
+
+        // Elements sharing a leading monomial meet before the set is interreduced, so a few may coexist.
+        auto bucketIterator = std::find_if(elements.begin(), elements.end(), [&] (const Bucket_ &bucket) {
+            return bucket.element.SharesTermsWith(element);
+        });
+        if (bucketIterator == elements.end()) {
+            bucketIterator = std::find_if(elements.begin(), elements.end(), [&] (const Bucket_ &bucket) {
+                return bucket.element == element;
+            });
+        }
+        if (bucketIterator == elements.end()) {
+            bucketIterator = elements.insert(elements.end(), Bucket_{element, {}});
+        }
+        auto &bucket = *bucketIterator;
+        // Sharing the terms makes the next check O(1).
+        bucket.element = element;
+
+        if (auto found = bucket.products.find(multiplier); found != bucket.products.end()) {
+            ++statistics_.hits;
+            recentlyUsed_.splice(recentlyUsed_.begin(), recentlyUsed_, found->second.use);
+            return found->second.product;
+        }
+
+        PolynomialType product;
+        const Entry_ *best = nullptr;
+        const Monomial *bestMultiplier = nullptr;
+        if (isSimplifying_) {
+            for (const auto &[stored, entry] : bucket.products) {
+                if (multiplier.IsDivisibleBy(stored) && (best == nullptr || stored.IsDivisibleBy(*bestMultiplier))) {
+                    best = &entry;
+                    bestMultiplier = &stored;
+                }
+            }
+        }
+
+        if (best != nullptr) {
+            ++statistics_.simplifiedHits;
+            product = MultiplyByMonomial(best->product, multiplier / *bestMultiplier);
+        } else {
+            ++statistics_.misses;
+            product = MultiplyByMonomial(element, multiplier);
+            if (isSimplifying_) {
+                product = SimplifyTail_(product, basis);
+            }
+        }
+
+        recentlyUsed_.emplace_front(leadingMonomial, &bucket, multiplier);
+        storedTerms_ += Size_(product);
+        bucket.products.emplace(multiplier, Entry_{product, recentlyUsed_.begin()});
+        Evict_();
+        return product;
+    }
+
+    [[nodiscard]] const MultipleCacheStatistics &GetStatistics() const noexcept {
+        return statistics_;
+    }
+
+    [[nodiscard]] size_t GetStoredTerms() const noexcept {
+        return storedTerms_;
+    }
+
+    void Clear() {
+        buckets_.clear();
+        recentlyUsed_.clear();
+        storedTerms_ = 0;
+    }
+
+private:
+    struct Bucket_;
+
+    // Leading monomial of the element, the element's bucket and the multiplier.
+    using Key_ = std::tuple<Monomial, Bucket_ *, Monomial>;
+
+    struct Entry_ {
+        PolynomialType product;
+        typename std::list<Key_>::iterator use;
+    };
+
+    struct Bucket_ {
+        PolynomialType element;
+        std::map<Monomial, Entry_, MonomialOrder> products;
+    };
+
+    static size_t Size_(const PolynomialType &polynomial) {
+        return std::distance(polynomial.begin(), polynomial.end());
+    }
+
+    // Keeps the leading term and reduces all others.
+    static PolynomialType SimplifyTail_(const PolynomialType &product, const PolynomialSetType &basis) {
+        PolynomialType leading(product.GetLeadingTerm());
+        return leading + HeapReduction(product - leading, basis);
+    }
+
+    // Least recently used products go first, until the stored ones fit into the limit.
+    void Evict_() {
+        while (storedTerms_ > maxTerms_ && !recentlyUsed_.empty()) {
+            const auto &[leadingMonomial, bucket, multiplier] = recentlyUsed_.back();
+            auto entry = bucket->products.find(multiplier);
+            storedTerms_ -= Size_(entry->second.product);
+            bucket->products.erase(entry);
+
+            if (bucket->products.empty()) {
+                auto &elements = buckets_.at(leadingMonomial);
+                elements.erase(std::find_if(elements.begin(), elements.end(), [&] (const Bucket_ &other) {
+                    return &other == bucket;
+                }));
+                if (elements.empty()) {
+                    buckets_.erase(leadingMonomial);
+                }
+            }
+            recentlyUsed_.pop_back();
+            ++statistics_.evictions;
+        }
+    }
+
+    size_t maxTerms_;
+    bool isSimplifying_;
+    size_t storedTerms_ = 0;
+    // Lists keep the buckets in place, the recently used keys point to them.
+    std::map<Monomial, std::list<Bucket_>, MonomialOrder> buckets_;
+    std::list<Key_> recentlyUsed_;
+    MultipleCacheStatistics statistics_;
+};
+
+// S-polynomial built from cached multiples of both elements.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+Polynomial<FieldType, MonomialOrder> SPolynomial(
+        const Polynomial<FieldType, MonomialOrder> &first,
+        const Polynomial<FieldType, MonomialOrder> &second,
+        const PolynomialSet<FieldType, MonomialOrder> &basis,
+        MonomialMultipleCache<FieldType, MonomialOrder> &cache)
+{
+    const auto l1 = first.GetLeadingTerm();
+    const auto l2 = second.GetLeadingTerm();
+    const auto termsLCM = Lcm(l1.first, l2.first);
+
+    return cache.Multiply(first, termsLCM / l1.first, basis) * l2.second -
+           cache.Multiply(second, termsLCM / l2.first, basis) * l1.second;
+}
+
+// BuhbergerAlgorithm with the S-polynomials taken from the cache.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+void BuhbergerAlgorithm(
+        PolynomialSet<FieldType, MonomialOrder> &set,
+        MonomialMultipleCache<FieldType, MonomialOrder> &cache,
+        const ReducerPolicy &policy = {},
+        size_t interreductionThreads = 1)
+{
+    auto findPairs = [&] {
+        PolynomialSet<FieldType, MonomialOrder> suitablePairs;
+        for (const auto &first : set) {
+            for (const auto &second : set) {
+                if (first == second) {
+                    break;
+                }
+                if (CheckLeadingTermsCoprime(first, second)) {
+                    continue;
+                }
+
+                auto S = SPolynomial(first, second, set, cache);
+                ChainOfReductionsOverSet(S, set, policy);
+                if (S != Polynomial<FieldType, MonomialOrder>(0)) {
+                    suitablePairs.insert(std::move(S));
+                }
+            }
+        }
+        return suitablePairs;
+    };
+
+    auto polynomialsToAdd = findPairs();
+    while (!polynomialsToAdd.empty()) {
+        OptimizeSet(set);
+        set.merge(polynomialsToAdd);
+        polynomialsToAdd = findPairs();
+    }
+    FinalInterreduction(set, interreductionThreads);
+}
+
+} // namespace GB
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "order.h"
+#include "rational.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+
+namespace GB {
+
+inline Monomial Gcd(const Monomial &first, const Monomial &second) {
+    Monomial::DegreeVector result(std::min(first.GetAmountOfVariables(), second.GetAmountOfVariables()));
+    for (Monomial::IndexType index = 0; index < result.size(); ++index) {
+        result[index] = std::min(first.GetDegree(index), second.GetDegree(index));
+    }
+    return Monomial(result);
+}
+
+// Greatest monomial dividing every term, the polynomial has to be non-zero.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+Monomial GetMonomialContent(const Polynomial<FieldType, MonomialOrder> &polynomial) {
+    Monomial content = polynomial.GetLeadingTerm().first;
+    for (const auto &[monomial, coefficient] : polynomial) {
+        content = Gcd(content, monomial);
+    }
+    return content;
+}
+
+// Division by a monomial keeps the order of terms, so the quotient is built by appending.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+Polynomial<FieldType, MonomialOrder> DivideByMonomial(
+        const Polynomial<FieldType, MonomialOrder> &polynomial,
+        const Monomial &divisor)
+{
+    Polynomial<FieldType, MonomialOrder> result;
+    for (const auto &[monomial, coefficient] : polynomial) {
+        assert(monomial.IsDivisibleBy(divisor));
+        result.PushBackTerm(monomial / divisor, coefficient);
+    }
+    return result;
+}
+
+// Scales a polynomial over Q to coprime integer coefficients with a positive leading one.
+template<SuitableOrder<Monomial> MonomialOrder>
+Polynomial<Rational<>, MonomialOrder> StripContent(const Polynomial<Rational<>, MonomialOrder> &polynomial) {
+    if (Polynomial<Rational<>, MonomialOrder>::IsZero(polynomial)) {
+        return polynomial;
+    }
+
+    DefaultIntegerType numeratorsGcd = 0, denominatorsLcm = 1;
+    for (const auto &[monomial, coefficient] : polynomial) {
+        numeratorsGcd = std::gcd(numeratorsGcd, coefficient.GetNumerator());
+        denominatorsLcm = std::lcm(denominatorsLcm, coefficient.GetDenominator());
+    }
+    if (polynomial.GetLeadingTerm().second < 0) {
+        numeratorsGcd = -numeratorsGcd;
+    }
+
+    return polynomial * Rational<>(denominatorsLcm, numeratorsGcd);
+}
+
+// Divides out the monomial common to all terms of all generators and, over Q, the content
+// of each generator. The ideal becomes J with I = content * J, so a reduced basis of I is
+// the reduced basis of J multiplied by the returned monomial.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+Monomial NormalizeGenerators(PolynomialSet<FieldType, MonomialOrder> &set) {
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+
+    std::optional<Monomial> content;
+    for (const auto &polynomial : set) {
+        if (!PolynomialType::IsZero(polynomial)) {
+            auto polynomialContent = GetMonomialContent(polynomial);
+            content = content.has_value() ? Gcd(*content, polynomialContent) : polynomialContent;
+        }
+    }
+
+    PolynomialSet<FieldType, MonomialOrder> normalizedSet;
+    for (const auto &polynomial : set) {
+        if (PolynomialType::IsZero(polynomial)) {
+            continue;
+        }
+        auto normalized = DivideByMonomial(polynomial, *content);
+        if constexpr (std::is_same_v<FieldType, Rational<>>) {
+            normalized = StripContent(normalized);
+        }
+        normalizedSet.insert(std::move(normalized));
+    }
+
+    set = std::move(normalizedSet);
+    return content.value_or(Monomial());
+}
+
+// Gröbner basis of the saturation I : monomial^∞, computed as the elimination of t from
+// I + (1 - t * monomial) in lexicographical order with t placed in front of all variables.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+PolynomialSet<FieldType, MonomialOrder> Saturate(
+        const PolynomialSet<FieldType, MonomialOrder> &set,
+        const Monomial &monomial)
+{
+    using LexPolynomial = Polynomial<FieldType, LexicographicalOrder>;
+
+    auto shift = [] (const Monomial &other) {
+        Monomial::DegreeVector degrees = other.GetDegrees();
+        degrees.insert(degrees.begin(), 0);
+        return Monomial(std::move(degrees));
+    };
+
+    PolynomialSet<FieldType, LexicographicalOrder> extended;
+    for (const auto &polynomial : set) {
+        LexPolynomial shifted;
+        for (const auto &[other, coefficient] : polynomial) {
+            shifted += LexPolynomial(typename LexPolynomial::Term(shift(other), coefficient));
+        }
+        if (!LexPolynomial::IsZero(shifted)) {
+            extended.insert(std::move(shifted));
+        }
+    }
+    extended.insert(LexPolynomial(FieldType(1)) - LexPolynomial(Monomial({1}) * shift(monomial)));
+    BuhbergerAlgorithm(extended);
+
+    PolynomialSet<FieldType, MonomialOrder> result;
+    for (const auto &polynomial : extended) {
+        if (polynomial.GetLeadingTerm().first.GetDegree(0) != 0) {
+            continue;
+        }
+
+        Polynomial<FieldType, MonomialOrder> unshifted;
+        for (const auto &[other, coefficient] : polynomial) {
+            Monomial::DegreeVector degrees;
+            if (!Monomial::HasNoVariables(other)) {
+                degrees.assign(std::next(other.GetDegrees().begin()), other.GetDegrees().end());
+            }
+            unshifted += Polynomial<FieldType, MonomialOrder>(
+                    typename Polynomial<FieldType, MonomialOrder>::Term(Monomial(std::move(degrees)), coefficient));
+        }
+        result.insert(std::move(unshifted));
+    }
+
+    BuhbergerAlgorithm(result);
+    return result;
+}
+
+} // namespace GB
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "division.h"
+#include "multiples.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+namespace GB {
+
+// Tuning knobs of BuhbergerAlgorithm(set, options), the defaults give the plain algorithm.
+struct BuchbergerOptions {
+    // Divide out the monomial common to all generators and, over Q, the integer content
+    // of every generator. The ideal does not change, the common monomial is multiplied back.
+    bool normalizeGenerators = false;
+    // Replace the ideal by its saturation with respect to the variables dividing some
+    // generator, which drops components lying on coordinate hyperplanes. Changes the ideal.
+    bool saturateMonomialFactors = false;
+    // Run the binomial engine when every generator has at most two terms.
+    bool useBinomialEngine = false;
+    // Solve the linear generators by Gaussian elimination and substitute their
+    // pivot variables into the others before the algorithm starts.
+    bool eliminateLinearEquations = false;
+    // Compute bases of generator groups over disjoint variable sets independently.
+    bool decomposeComponents = false;
+    // Threads for independent components, 0 means std::thread::hardware_concurrency.
+    size_t amountOfThreads = 0;
+    // Reduce and normalize the elements of the final basis concurrently on amountOfThreads threads.
+    bool parallelInterreduction = false;
+    // Reduce S-pairs on amountOfThreads threads sharing a ConcurrentBasis, implies parallelInterreduction.
+    bool useConcurrentBasis = false;
+    // Over Q: compute the basis modulo one prime and lift it p-adically, falling back
+    // to the rational computation when the prime turns out unlucky.
+    bool usePAdicLifting = false;
+    // Over Q: reduce every S-pair modulo a random word-size prime first and skip
+    // the rational reduction when the modular remainder is zero.
+    bool useModularPreFilter = false;
+    // Check the pre-filtered result with IsGroebnerBasis and recompute it without
+    // the pre-filter if a pair was skipped wrongly.
+    bool verifyPreFilteredResult = true;
+    // Which eligible basis element reduces a term of an S-polynomial.
+    ReducerSelection reducerSelection = ReducerSelection::kFirst;
+    // Receives the reducer choices when set, the caller owns it.
+    ReductionStatistics *statistics = nullptr;
+    // Reduce S-pairs in dense coefficient arrays, for few variables and low degrees.
+    bool useDenseArithmetic = false;
+    // Limit in terms for the cache of monomial multiples of basis elements, 0 disables it.
+    size_t multipleCacheTerms = 0;
+    // Reduce the tails of cached multiples and answer m * g by (m / u) * (u * g) when possible.
+    bool simplifyMultiples = false;
+    // Receives the hit statistics of the cache when set, the caller owns it.
+    MultipleCacheStatistics *multipleCacheStatistics = nullptr;
+    // Seed for the random primes, 0 means std::random_device.
+    uint64_t seed = 0;
+};
+
+} // namespace GB
@@ -4,7 +4,10 @@
 #include "rational.h"
 #include "monomial.h"
 #include "order.h"
+#include "kronecker.h"
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <map>
 
@@ -19,37 +22,58 @@ public:
 
     Polynomial() = default;
 
-    Polynomial(std::initializer_list<Term> terms) : terms_(terms) {
+    Polynomial(std::initializer_list<Term> terms) : terms_(std::make_shared<TermMap>(terms)) {
         Shrink_();
     }
 
-    Polynomial(Monomial monomial) : terms_{{std::move(monomial), 1}} {
+    Polynomial(Monomial monomial) : terms_(std::make_shared<TermMap>()) {
+        terms_->emplace(std::move(monomial), 1);
     }
 
-    explicit constexpr Polynomial(Term term) : terms_{std::move(term)} {
+    explicit Polynomial(Term term) : terms_(std::make_shared<TermMap>()) {
+        terms_->insert(std::move(term));
         Shrink_();
     }
 
-    Polynomial(FieldType coefficient) : terms_{{{}, std::move(coefficient)}} {
+    Polynomial(FieldType coefficient) : terms_(std::make_shared<TermMap>()) {
+        terms_->emplace(Monomial(), std::move(coefficient));
         Shrink_();
     }
 
     template<SuitableOrder<Monomial> OtherMonomialOrder>
-    Polynomial(const Polynomial<FieldType, OtherMonomialOrder> &other) {
+    Polynomial(const Polynomial<FieldType, OtherMonomialOrder> &other) : terms_(std::make_shared<TermMap>()) {
         for (const auto &term : other) {
-            terms_.insert(term);
+            terms_->insert(term);
         }
     }
 
     [[nodiscard]] IndexType GetAmountOfTerms() const noexcept {
-        return terms_.size();
+        return Terms_().size();
     }
 
     Term GetNthTerm(IndexType index) const {
-        assert(index < terms_.size());
+        assert(index < Terms_().size());
         return *std::next(begin(), index);
     }
 
+    // Appends a term that is smaller than every present one. Algorithms producing terms
+    // in decreasing order use it to build results without searching the map.
+    void PushBackTerm(Monomial monomial, FieldType coefficient) {
+        if (coefficient == 0) {
+            return;
+        }
+
+        auto &terms = MutableTerms_();
+        assert(terms.empty() || terms.key_comp()(monomial, terms.begin()->first));
+        terms.emplace_hint(terms.begin(), std::move(monomial), std::move(coefficient));
+    }
+
+    // Copies share their terms until one of them is modified, so this is the way
+    // to check that a copy was O(1).
+    [[nodiscard]] bool SharesTermsWith(const Polynomial &other) const noexcept {
+        return terms_ != nullptr && terms_ == other.terms_;
+    }
+
     Term GetLeadingTerm() const {
         return *begin();
     }
@@ -68,6 +92,8 @@ public:
     }
 
     Polynomial &operator+=(const Polynomial &other) {
+        // Holding a reference keeps the terms alive and forces a detach for p += p.
+        const auto otherTerms = other.terms_;
         for (const auto &term : other) {
             AddTerm_(term);
         }
@@ -84,6 +110,7 @@ public:
     }
 
     Polynomial &operator-=(const Polynomial &other) {
+        const auto otherTerms = other.terms_;
         for (const auto &term : other) {
             SubtractTerm_(term);
         }
@@ -106,6 +133,17 @@ public:
 
     friend Polynomial operator*(const Polynomial &lhs, const Polynomial &rhs) {
         Polynomial result;
+
+        if constexpr (PrimeFieldType<FieldType>) {
+            if (KroneckerMultiplier::IsWorthwhile<FieldType>(lhs.Terms_(), rhs.Terms_())) {
+                result.terms_ = std::make_shared<TermMap>(
+                        KroneckerMultiplier::Multiply<FieldType>(lhs.Terms_(), rhs.Terms_()));
+
+                result.CheckInvariants_();
+                return result;
+            }
+        }
+
         for (const auto &leftTerm : lhs) {
             for (const auto &rightTerm : rhs) {
                 result.AddTerm_(Term{leftTerm.first * rightTerm.first, leftTerm.second * rightTerm.second});
@@ -116,59 +154,61 @@ public:
         return result;
     }
 
-    typename TermMap::reverse_iterator begin() noexcept {
-        return terms_.rbegin();
+    // Non-const iterators give write access to the terms, so they detach shared storage first.
+
+    typename TermMap::reverse_iterator begin() {
+        return MutableTerms_().rbegin();
     }
 
     typename TermMap::const_reverse_iterator begin() const noexcept {
-        return terms_.crbegin();
+        return Terms_().crbegin();
     }
 
     typename TermMap::const_reverse_iterator cbegin() const noexcept {
-        return terms_.crbegin();
+        return Terms_().crbegin();
     }
 
-    typename TermMap::iterator rbegin() noexcept {
-        return terms_.begin();
+    typename TermMap::iterator rbegin() {
+        return MutableTerms_().begin();
     }
 
     typename TermMap::const_iterator rbegin() const noexcept {
-        return terms_.cbegin();
+        return Terms_().cbegin();
     }
 
     typename TermMap::const_iterator crbegin() const noexcept {
-        return terms_.cbegin();
+        return Terms_().cbegin();
     }
 
-    typename TermMap::reverse_iterator end() noexcept {
-        return terms_.rend();
+    typename TermMap::reverse_iterator end() {
+        return MutableTerms_().rend();
     }
 
     typename TermMap::const_reverse_iterator end() const noexcept {
-        return terms_.crend();
+        return Terms_().crend();
     }
 
     typename TermMap::const_reverse_iterator cend() const noexcept {
-        return terms_.crend();
+        return Terms_().crend();
     }
 
-    typename TermMap::iterator rend() noexcept {
-        return terms_.end();
+    typename TermMap::iterator rend() {
+        return MutableTerms_().end();
     }
 
     typename TermMap::const_iterator rend() const noexcept {
-        return terms_.cend();
+        return Terms_().cend();
     }
 
     typename TermMap::const_iterator crend() const noexcept {
-        return terms_.cend();
+        return Terms_().cend();
     }
 
     friend bool operator==(const Polynomial &lhs, const Polynomial &rhs) {
         lhs.CheckInvariants_();
         rhs.CheckInvariants_();
 
-        return lhs.terms_ == rhs.terms_;
+        return lhs.terms_ == rhs.terms_ || lhs.Terms_() == rhs.Terms_();
     }
 
     friend bool operator!=(const Polynomial &lhs, const Polynomial &rhs) {
@@ -176,7 +216,7 @@ public:
     }
 
     static bool IsZero(const Polynomial &other) {
-        return other.terms_.empty();
+        return other.Terms_().empty();
     }
 
     friend std::ostream &operator<<(std::ostream &out, const Polynomial &other) {
@@ -220,49 +260,71 @@ private:
     }
 
     void AddTerm_(const Term &term) {
-        auto foundTerm = terms_.lower_bound(term.first);
+        auto &terms = MutableTerms_();
+        auto foundTerm = terms.lower_bound(term.first);
 
-        if (foundTerm != terms_.end() && foundTerm->first == term.first) {
+        if (foundTerm != terms.end() && foundTerm->first == term.first) {
             foundTerm->second += term.second;
             if (foundTerm->second == 0) {
-                terms_.erase(foundTerm);
+                terms.erase(foundTerm);
             }
         } else {
-            terms_.insert(foundTerm, term);
+            terms.insert(foundTerm, term);
         }
     }
 
     void SubtractTerm_(const Term &term) {
-        auto foundTerm = terms_.lower_bound(term.first);
+        auto &terms = MutableTerms_();
+        auto foundTerm = terms.lower_bound(term.first);
 
-        if (foundTerm != terms_.end() && foundTerm->first == term.first) {
+        if (foundTerm != terms.end() && foundTerm->first == term.first) {
             foundTerm->second -= term.second;
 
             if (foundTerm->second == 0) {
-                terms_.erase(foundTerm);
+                terms.erase(foundTerm);
             }
         } else {
-            terms_.insert(foundTerm, {term.first, -term.second});
+            terms.insert(foundTerm, {term.first, -term.second});
         }
     }
 
     void CheckInvariants_() const noexcept {
-        assert(std::none_of(terms_.begin(), terms_.end(), [] (const Term &term) {
+        assert(std::none_of(Terms_().begin(), Terms_().end(), [] (const Term &term) {
             return term.second == 0;
         }));
     }
 
     void Shrink_() {
-        for (auto iter = terms_.begin(); iter != terms_.end();) {
+        auto &terms = MutableTerms_();
+        for (auto iter = terms.begin(); iter != terms.end();) {
             if (iter->second == 0) {
-                iter = terms_.erase(iter);
+                iter = terms.erase(iter);
             } else {
                 ++iter;
             }
         }
     }
 
-    TermMap terms_;
+    // Default constructed and moved-from polynomials have no storage at all and read as zero.
+    const TermMap &Terms_() const noexcept {
+        static const TermMap kEmptyTerms;
+        return terms_ ? *terms_ : kEmptyTerms;
+    }
+
+    // Copy-on-write: the terms are cloned only if some other polynomial still refers to them.
+    TermMap &MutableTerms_() {
+        if (!terms_) {
+            terms_ = std::make_shared<TermMap>();
+        } else if (terms_.use_count() > 1) {
+            terms_ = std::make_shared<TermMap>(*terms_);
+        } else {
+            // Pairs with the release done by the last other owner when it dropped its reference.
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *terms_;
+    }
+
+    std::shared_ptr<TermMap> terms_;
 
     template<SuitableFieldType>
     friend struct Less;
@@ -277,7 +339,7 @@ explicit Polynomial(std::initializer_list<std::pair<Monomial, int>>) -> Polynomi
 template<SuitableFieldType FieldType = Rational<>>
 struct Less {
     bool operator()(const Polynomial<FieldType> &lhs, const Polynomial<FieldType> &rhs) const noexcept {
-        return lhs.terms_ < rhs.terms_;
+        return lhs.terms_ != rhs.terms_ && lhs.Terms_() < rhs.Terms_();
     }
 };
 
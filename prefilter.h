@@ -0,0 +1,147 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "division.h"
+#include "modular.h"
+#include "options.h"
+#include "rational.h"
+#include "verification.h"
+
+#include <cstdint>
+
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace GB {
+
+// Images of a rational set modulo one prime, answers whether an S-pair of two
+// elements of that set reduces to zero modulo the prime. The set has to outlive the filter.
+template<SuitableOrder<Monomial> MonomialOrder>
+class ModularPreFilter {
+public:
+    using RationalPolynomial = Polynomial<Rational<>, MonomialOrder>;
+    using ModularPolynomial = Polynomial<RuntimeModular, MonomialOrder>;
+
+    static constexpr uint32_t kMinPrime = ModularVerifier::kMinPrime;
+    static constexpr uint32_t kMaxPrime = ModularVerifier::kMaxPrime;
+
+    ModularPreFilter(const PolynomialSet<Rational<>, MonomialOrder> &set, uint32_t prime) : prime_(prime) {
+        RuntimeModular::ModulusScope scope(prime_);
+
+        images_.reserve(set.size());
+        for (const auto &polynomial : set) {
+            auto image = ToModular_(polynomial);
+            if (!image.has_value()) {
+                isUsable_ = false;
+                return;
+            }
+            indices_.emplace(&polynomial, images_.size());
+            images_.push_back(std::move(*image));
+        }
+    }
+
+    // False when the prime divides a denominator or a leading coefficient of the set.
+    [[nodiscard]] bool IsUsable() const noexcept {
+        return isUsable_;
+    }
+
+    [[nodiscard]] uint32_t GetPrime() const noexcept {
+        return prime_;
+    }
+
+    [[nodiscard]] size_t GetAmountOfSkippedPairs() const noexcept {
+        return amountOfSkippedPairs_;
+    }
+
+    // Both arguments have to be elements of the set, the divisors are taken in the
+    // order of the set, so the modular reduction mirrors the rational one.
+    bool ReducesToZero(const RationalPolynomial &first, const RationalPolynomial &second) {
+        if (!isUsable_) {
+            return false;
+        }
+
+        RuntimeModular::ModulusScope scope(prime_);
+        const auto &firstImage = images_[indices_.at(&first)];
+        const auto &secondImage = images_[indices_.at(&second)];
+
+        if (!ModularPolynomial::IsZero(HeapReduction(SPolynomialStream(firstImage, secondImage), images_))) {
+            return false;
+        }
+
+        ++amountOfSkippedPairs_;
+        return true;
+    }
+
+    template<typename Generator>
+    static uint32_t DrawPrime(Generator &generator) {
+        std::uniform_int_distribution<uint32_t> distribution(kMinPrime, kMaxPrime);
+
+        uint32_t prime;
+        do {
+            prime = distribution(generator);
+        } while (!ModularVerifier::IsPrime(prime));
+
+        return prime;
+    }
+
+private:
+    std::optional<ModularPolynomial> ToModular_(const RationalPolynomial &polynomial) const {
+        if (RationalPolynomial::IsZero(polynomial) ||
+            polynomial.GetLeadingTerm().second.GetNumerator() % static_cast<int64_t>(prime_) == 0) {
+            return std::nullopt;
+        }
+
+        ModularPolynomial image;
+        for (const auto &[monomial, coefficient] : polynomial) {
+            if (coefficient.GetDenominator() % static_cast<int64_t>(prime_) == 0) {
+                return std::nullopt;
+            }
+            image.PushBackTerm(monomial, RuntimeModular(coefficient.GetNumerator()) /
+                                         RuntimeModular(coefficient.GetDenominator()));
+        }
+
+        return image;
+    }
+
+    uint32_t prime_;
+    bool isUsable_ = true;
+    size_t amountOfSkippedPairs_ = 0;
+    std::vector<ModularPolynomial> images_;
+    std::unordered_map<const RationalPolynomial *, size_t> indices_;
+};
+
+// Buchberger's algorithm over Q with the pre-filter, seed and verification are taken from the options.
+template<SuitableOrder<Monomial> MonomialOrder>
+void PreFilteredBuhbergerAlgorithm(PolynomialSet<Rational<>, MonomialOrder> &set, const BuchbergerOptions &options) {
+    auto generators = set;
+    std::mt19937_64 generator(options.seed != 0 ? options.seed : std::random_device()());
+
+    // A fresh prime every round, the set changes anyway and an unlucky prime does not stick.
+    auto findPairs = [&] {
+        ModularPreFilter<MonomialOrder> filter(set, ModularPreFilter<MonomialOrder>::DrawPrime(generator));
+        return FindPairs(set, [&filter] (const auto &first, const auto &second) {
+            return filter.ReducesToZero(first, second);
+        }, ReducerPolicy{options.reducerSelection, options.statistics});
+    };
+
+    auto polynomialsToAdd = findPairs();
+    OptimizeSet(set);
+
+    while (!polynomialsToAdd.empty()) {
+        set.merge(polynomialsToAdd);
+        polynomialsToAdd = findPairs();
+        OptimizeSet(set);
+    }
+
+    // Every element still lies in the ideal, only the basis property can be lost.
+    if (options.verifyPreFilteredResult && !IsGroebnerBasis(set)) {
+        set = std::move(generators);
+        BuhbergerAlgorithm(set);
+    }
+}
+
+} // namespace GB
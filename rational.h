@@ -40,11 +40,11 @@ public:
     }
 
     [[nodiscard]] IntegerType GetNumerator() const noexcept {
-        return numerator_;
+        return static_cast<IntegerType>(numerator_);
     }
 
     [[nodiscard]] IntegerType GetDenominator() const noexcept {
-        return denominator_;
+        return static_cast<IntegerType>(denominator_);
     }
 
     void Invert() {
@@ -65,7 +65,7 @@ public:
 
     explicit operator double() const {
         assert(denominator_ != 0);
-        return static_cast<double>(numerator_) / denominator_;
+        return static_cast<double>(static_cast<IntegerType>(numerator_)) / static_cast<IntegerType>(denominator_);
     }
 
     Rational operator+() const {
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "buchberger.h"
+#include "decomposition.h"
+#include "elimination.h"
+#include "normalization.h"
+#include "options.h"
+#include "rational.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace GB {
+
+struct InputFeatures {
+    size_t amountOfGenerators = 0;
+    size_t amountOfVariables = 0;
+    size_t maxDegree = 0;
+    size_t amountOfTerms = 0;
+    // Average share of the monomials of degree at most maxDegree occurring in a generator.
+    double density = 0;
+    bool isHomogeneous = true;
+    size_t amountOfLinearGenerators = 0;
+    // Bits of the largest numerator or denominator over Q, 0 for other fields.
+    size_t maxCoefficientBits = 0;
+    size_t amountOfComponents = 0;
+    bool hasCommonMonomialFactor = false;
+    // Every generator has at most two terms.
+    bool isBinomial = true;
+};
+
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+InputFeatures AnalyzeInput(const PolynomialSet<FieldType, MonomialOrder> &set) {
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+
+    InputFeatures features;
+    std::optional<Monomial> commonFactor;
+    for (const auto &polynomial : set) {
+        if (PolynomialType::IsZero(polynomial)) {
+            continue;
+        }
+        ++features.amountOfGenerators;
+        features.isBinomial &= polynomial.GetAmountOfTerms() <= 2;
+
+        const auto degree = polynomial.GetLeadingTerm().first.TotalDegree();
+        for (const auto &[monomial, coefficient] : polynomial) {
+            ++features.amountOfTerms;
+            features.amountOfVariables = std::max(features.amountOfVariables, monomial.GetAmountOfVariables());
+            features.maxDegree = std::max(features.maxDegree, static_cast<size_t>(monomial.TotalDegree()));
+            features.isHomogeneous &= monomial.TotalDegree() == degree;
+
+            if constexpr (std::is_same_v<FieldType, Rational<>>) {
+                for (auto value : {coefficient.GetNumerator(), coefficient.GetDenominator()}) {
+                    features.maxCoefficientBits = std::max<size_t>(features.maxCoefficientBits,
+                                                                   std::bit_width(static_cast<uint64_t>(std::abs(value))));
+                }
+            }
+        }
+
+        features.amountOfLinearGenerators += LinearElimination<FieldType, MonomialOrder>::IsLinear(polynomial);
+        auto content = GetMonomialContent(polynomial);
+        commonFactor = commonFactor.has_value() ? Gcd(*commonFactor, content) : content;
+    }
+
+    features.hasCommonMonomialFactor = commonFactor.has_value() && !Monomial::HasNoVariables(*commonFactor);
+    features.amountOfComponents = SplitIntoComponents(set).size();
+    if (features.amountOfGenerators != 0) {
+        // C(n + d, d) monomials of degree at most d in n variables.
+        double amountOfMonomials = 1;
+        for (size_t step = 1; step <= features.maxDegree; ++step) {
+            amountOfMonomials *= static_cast<double>(features.amountOfVariables + step) / static_cast<double>(step);
+        }
+        features.density = static_cast<double>(features.amountOfTerms) / features.amountOfGenerators / amountOfMonomials;
+    }
+
+    return features;
+}
+
+inline std::ostream &operator<<(std::ostream &out, const InputFeatures &features) {
+    out << features.amountOfGenerators << " generators, " << features.amountOfVariables << " variables, degree "
+        << features.maxDegree << ", " << features.amountOfTerms << " terms, density " << features.density << ", "
+        << (features.isHomogeneous ? "homogeneous" : "inhomogeneous") << ", " << features.amountOfLinearGenerators
+        << " linear, " << features.amountOfComponents << " components";
+    if (features.maxCoefficientBits != 0) {
+        out << ", " << features.maxCoefficientBits << "-bit coefficients";
+    }
+    if (features.hasCommonMonomialFactor) {
+        out << ", common monomial factor";
+    }
+    if (features.isBinomial) {
+        out << ", binomial";
+    }
+    return out;
+}
+
+struct StrategyDecision {
+    BuchbergerOptions options;
+    std::string description;
+};
+
+// Thresholds are read off BenchmarkStrategies in benchmark.cpp. Without an order conversion
+// like FGLM, computing a graded basis first never paid off, so the requested order is used
+// directly. The modular pre-filter lost on every family that Rational<> survives and is not
+// chosen, p-adic lifting won from four variables and generators with more than toy coefficients.
+// Dense arithmetic won on dense bivariate systems and broke even from three variables on.
+class StrategySelector {
+public:
+    static constexpr size_t kMinLiftingVariables = 4;
+    static constexpr size_t kMinLiftingGenerators = 4;
+    static constexpr size_t kMinLiftingCoefficientBits = 3;
+    // Below this many terms a thread costs more than the component it would compute.
+    static constexpr size_t kMinParallelTerms = 64;
+    static constexpr size_t kMaxDenseVariables = 2;
+    static constexpr double kMinDenseDensity = 0.25;
+
+    template<SuitableFieldType FieldType>
+    static StrategyDecision Select(const InputFeatures &features) {
+        StrategyDecision decision;
+        auto &options = decision.options;
+        std::ostringstream description;
+        if (features.isBinomial) {
+            options.useBinomialEngine = true;
+            description << "engine: binomial";
+        } else {
+            description << "engine: Buchberger";
+        }
+
+        if (features.hasCommonMonomialFactor) {
+            options.normalizeGenerators = true;
+            description << " + normalization";
+        }
+        // The binomial engine runs right after the normalization, the later passes would never be reached.
+        if (features.amountOfLinearGenerators != 0 && !features.isBinomial) {
+            options.eliminateLinearEquations = true;
+            description << " + linear elimination";
+        }
+        if (features.amountOfComponents > 1 && !features.isBinomial) {
+            options.decomposeComponents = true;
+            options.amountOfThreads = features.amountOfTerms < kMinParallelTerms ? 1 :
+                    std::min<size_t>(features.amountOfComponents, std::max(1u, std::thread::hardware_concurrency()));
+            description << " + " << features.amountOfComponents << " components";
+        } else {
+            options.amountOfThreads = 1;
+        }
+        description << "; threads: " << options.amountOfThreads;
+
+        description << "; coefficients: ";
+        if (std::is_same_v<FieldType, Rational<>> && !features.isBinomial &&
+            features.amountOfVariables >= kMinLiftingVariables &&
+            features.amountOfGenerators >= kMinLiftingGenerators &&
+            features.maxCoefficientBits >= kMinLiftingCoefficientBits) {
+            options.usePAdicLifting = true;
+            description << "p-adic lifting";
+        } else {
+            description << "direct";
+        }
+        description << "; order: direct";
+
+        description << "; arithmetic: ";
+        if (!features.isBinomial && features.amountOfVariables <= kMaxDenseVariables &&
+            features.density >= kMinDenseDensity) {
+            options.useDenseArithmetic = true;
+            description << "dense";
+        } else {
+            description << "sparse";
+        }
+
+        decision.description = description.str();
+        return decision;
+    }
+};
+
+// Inspects the input, picks the options and reports the decision to the log if one is given.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+StrategyDecision AutoBuhbergerAlgorithm(PolynomialSet<FieldType, MonomialOrder> &set, std::ostream *log = nullptr) {
+    auto features = AnalyzeInput(set);
+    auto decision = StrategySelector::Select<FieldType>(features);
+
+    if (log != nullptr) {
+        *log << "Input: " << features << "\n" << "Strategy: " << decision.description << "\n";
+    }
+
+    BuhbergerAlgorithm(set, decision.options);
+    return decision;
+}
+
+} // namespace GB
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+
+#include <optional>
+#include <utility>
+
+namespace GB {
+
+// Lazy source of the terms of a polynomial in decreasing monomial order. Streams are pulled
+// by the consumer one term at a time, so an expression like m * f - c * g is never built as
+// a polynomial when it is only read once. A stream refers to the polynomials it reads,
+// they must outlive it.
+template<typename T>
+concept TermStream = requires(T stream) {
+    typename T::PolynomialType;
+    { stream.IsEnd() } -> IsSame<bool>;
+    stream.GetTerm().first;
+    stream.GetTerm().second;
+    stream.Advance();
+};
+
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+class PolynomialTermStream {
+public:
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+
+    explicit PolynomialTermStream(const PolynomialType &polynomial)
+        : current_(polynomial.begin()), end_(polynomial.end())
+    {
+    }
+
+    [[nodiscard]] bool IsEnd() const noexcept {
+        return current_ == end_;
+    }
+
+    [[nodiscard]] const typename PolynomialType::Term &GetTerm() const noexcept {
+        return *current_;
+    }
+
+    void Advance() noexcept {
+        ++current_;
+    }
+
+private:
+    typename PolynomialType::TermMap::const_reverse_iterator current_;
+    typename PolynomialType::TermMap::const_reverse_iterator end_;
+};
+
+// The terms of (coefficient * multiplier) * stream. Multiplication by a monomial keeps the order.
+template<TermStream Stream>
+class ScaledTermStream {
+public:
+    using PolynomialType = typename Stream::PolynomialType;
+    using FieldType = typename PolynomialType::Term::second_type;
+
+    ScaledTermStream(Stream stream, Monomial multiplier, FieldType coefficient)
+        : stream_(std::move(stream)), multiplier_(std::move(multiplier)), coefficient_(std::move(coefficient))
+    {
+        Load_();
+    }
+
+    [[nodiscard]] bool IsEnd() const noexcept {
+        return !current_.has_value();
+    }
+
+    [[nodiscard]] const std::pair<Monomial, FieldType> &GetTerm() const noexcept {
+        return *current_;
+    }
+
+    void Advance() {
+        stream_.Advance();
+        Load_();
+    }
+
+private:
+    void Load_() {
+        if (coefficient_ == FieldType(0) || stream_.IsEnd()) {
+            current_.reset();
+        } else {
+            const auto &term = stream_.GetTerm();
+            current_.emplace(term.first * multiplier_, term.second * coefficient_);
+        }
+    }
+
+    Stream stream_;
+    Monomial multiplier_;
+    FieldType coefficient_;
+    std::optional<std::pair<Monomial, FieldType>> current_;
+};
+
+// The terms of first + second, equal monomials are merged and cancelled terms skipped.
+template<TermStream First, TermStream Second>
+class SumTermStream {
+public:
+    using PolynomialType = typename First::PolynomialType;
+    using FieldType = typename PolynomialType::Term::second_type;
+    using MonomialOrder = typename PolynomialType::TermMap::key_compare;
+
+    SumTermStream(First first, Second second) : first_(std::move(first)), second_(std::move(second)) {
+        Load_();
+    }
+
+    [[nodiscard]] bool IsEnd() const noexcept {
+        return !current_.has_value();
+    }
+
+    [[nodiscard]] const std::pair<Monomial, FieldType> &GetTerm() const noexcept {
+        return *current_;
+    }
+
+    void Advance() {
+        Load_();
+    }
+
+private:
+    // Moves both sources past the next non-zero term of the sum.
+    void Load_() {
+        current_.reset();
+        while (!current_.has_value() && (!first_.IsEnd() || !second_.IsEnd())) {
+            if (second_.IsEnd() || (!first_.IsEnd() && order_(second_.GetTerm().first, first_.GetTerm().first))) {
+                current_.emplace(first_.GetTerm().first, first_.GetTerm().second);
+                first_.Advance();
+            } else if (first_.IsEnd() || order_(first_.GetTerm().first, second_.GetTerm().first)) {
+                current_.emplace(second_.GetTerm().first, second_.GetTerm().second);
+                second_.Advance();
+            } else {
+                FieldType coefficient = first_.GetTerm().second + second_.GetTerm().second;
+                if (coefficient != FieldType(0)) {
+                    current_.emplace(first_.GetTerm().first, std::move(coefficient));
+                }
+                first_.Advance();
+                second_.Advance();
+            }
+        }
+    }
+
+    First first_;
+    Second second_;
+    MonomialOrder order_;
+    std::optional<std::pair<Monomial, FieldType>> current_;
+};
+
+// Builds the polynomial of the remaining terms.
+template<TermStream Stream>
+typename Stream::PolynomialType Collect(Stream stream) {
+    typename Stream::PolynomialType result;
+    for (; !stream.IsEnd(); stream.Advance()) {
+        const auto &term = stream.GetTerm();
+        result.PushBackTerm(term.first, term.second);
+    }
+    return result;
+}
+
+} // namespace GB
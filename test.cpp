@@ -4,6 +4,22 @@
 #include "monomial.h"
 #include "polynomial.h"
 #include "algorithms.h"
+#include "modular.h"
+#include "cofactors.h"
+#include "evaluation.h"
+#include "gf2.h"
+#include "boolean.h"
+#include "galois.h"
+#include "lifting.h"
+#include "verification.h"
+#include "buchberger.h"
+#include "strategy.h"
+
+#include <atomic>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <type_traits>
 
 #define EXPECT_TRUE(expression) assert(!!(expression))
 
@@ -136,6 +152,74 @@ namespace GB {
             EXPECT_EQUAL(f1 - f2, Polynomial(Term{{1, 2}, 26}));
             EXPECT_EQUAL(f1 + f2, Polynomial(Term{{1, 2}, 6}));
         }
+
+        {
+            Polynomial copy = p1;
+            EXPECT_TRUE(copy.SharesTermsWith(p1));
+
+            copy += p2;
+            EXPECT_FALSE(copy.SharesTermsWith(p1));
+            EXPECT_EQUAL(p1, Polynomial({{{1, 2, 3}, 1}, {{0, 1}, 8}}));
+
+            Polynomial doubled = p1;
+            doubled += doubled;
+            EXPECT_EQUAL(doubled, p1 * Polynomial(2));
+
+            Polynomial moved = std::move(copy);
+            EXPECT_TRUE(Polynomial<>::IsZero(copy));
+            EXPECT_EQUAL(moved, p1 + p2);
+        }
+    }
+
+    void TestModular() {
+        using Field = Modular<7>;
+
+        EXPECT_THROW(Field(0).GetInverted());
+        EXPECT_EQUAL(Field(-1), Field(6));
+        EXPECT_EQUAL(Field(3) * Field(5), Field(1));
+        EXPECT_EQUAL(Field(3).GetInverted(), Field(5));
+        EXPECT_EQUAL(Field(2) / Field(4), Field(4));
+        EXPECT_EQUAL(Field(2) - Field(5), Field(4));
+        EXPECT_EQUAL(-Field(0), Field(0));
+        EXPECT_EQUAL(Field::Pow(3, 6), Field(1));
+
+        constexpr uint64_t kLargePrime = 4611686018427387847;
+        using LargeField = LargeModular<kLargePrime>;
+
+        EXPECT_THROW(LargeField(0).GetInverted());
+        EXPECT_EQUAL(LargeField(-1).GetValue(), kLargePrime - 1);
+        EXPECT_EQUAL(LargeField(INT64_MIN).GetValue(), kLargePrime - uint64_t(INT64_MIN) % kLargePrime);
+        EXPECT_EQUAL(LargeField(3) * LargeField(5), LargeField(15));
+        EXPECT_EQUAL(LargeField(3) * LargeField(3).GetInverted(), LargeField(1));
+        EXPECT_EQUAL(LargeField::Pow(12345, kLargePrime - 1), LargeField(1));
+
+        uint64_t lhs = kLargePrime - 12345, rhs = kLargePrime / 3;
+        auto expected = static_cast<uint64_t>(static_cast<unsigned __int128>(lhs) * rhs % kLargePrime);
+        EXPECT_EQUAL((LargeField(lhs) * LargeField(rhs)).GetValue(), expected);
+        EXPECT_EQUAL((LargeField(lhs) + LargeField(rhs)).GetValue(), lhs + rhs - kLargePrime);
+    }
+
+    void TestKroneckerMultiplication() {
+        using Field = Modular<1000003>;
+        using ModularPolynomial = Polynomial<Field, GradedLexicographicalOrder>;
+
+        ModularPolynomial lhs, rhs;
+        for (uint64_t i = 0; i < 10; ++i) {
+            for (uint64_t j = 0; j < 10; ++j) {
+                lhs += ModularPolynomial(ModularPolynomial::Term{{i, j}, static_cast<int64_t>(i * 31 + j * 7 + 1)});
+                rhs += ModularPolynomial(ModularPolynomial::Term{{j, i}, static_cast<int64_t>(1000000 - i * j)});
+            }
+        }
+
+        // Single-term products stay on the sparse path, so this is an independent reference.
+
+        ModularPolynomial expected;
+        for (const auto &term : rhs) {
+            expected += lhs * ModularPolynomial(term);
+        }
+
+        EXPECT_EQUAL(lhs * rhs, expected);
+        EXPECT_EQUAL(lhs * ModularPolynomial{}, ModularPolynomial{});
     }
 
     void TestOrder() {
@@ -234,13 +318,1029 @@ namespace GB {
         }
     }
 
+    void TestHeapDivision() {
+        using GrlexPolynomial = Polynomial<Rational<>, GradedLexicographicalOrder>;
+
+        GrlexPolynomial g1({{{1, 1}, 1}, {{0, 0, 1}, -1}});
+        GrlexPolynomial g2({{{0, 2}, 2}, {{1}, 3}, {{}, -1}});
+        GrlexPolynomial f({{{3, 3, 1}, 5}, {{2, 2}, Rational<>(1, 2)}, {{0, 4}, 7}, {{1, 0, 2}, -3}, {{}, 4}});
+
+        std::vector<GrlexPolynomial> divisors = {g1, g2};
+        HeapDivision<Rational<>, GradedLexicographicalOrder> division(divisors);
+        auto remainder = division.Reduce(f);
+        auto quotients = division.GetQuotients();
+
+        EXPECT_EQUAL(quotients.size(), 2ull);
+        EXPECT_EQUAL(quotients[0] * g1 + quotients[1] * g2 + remainder, f);
+        EXPECT_TRUE(division.GetReductionCount() > 0);
+        for (const auto &[monomial, coefficient] : remainder) {
+            EXPECT_FALSE(monomial.IsDivisibleBy(g1.GetLeadingTerm().first));
+            EXPECT_FALSE(monomial.IsDivisibleBy(g2.GetLeadingTerm().first));
+        }
+
+        {
+            auto reducible = f;
+            ChainOfElementaryReductions(reducible, g1);
+            EXPECT_EQUAL(HeapReduction(f, std::vector<GrlexPolynomial>{g1}), reducible);
+        }
+
+        EXPECT_EQUAL(HeapReduction(g1 * g2, divisors), GrlexPolynomial{});
+        EXPECT_EQUAL(HeapReduction(f, std::vector<GrlexPolynomial>{}), f);
+    }
+
+    void TestCofactors() {
+        Polynomial f1 = Polynomial(Term{{2}, 1}) + Polynomial(Term{{1}, 2}) - Polynomial(Term{{0, 1}, 4});
+        Polynomial f2 = Polynomial(Term{{0, 2}, 1}) + Polynomial(Term{{1, 1}, 1}) - Polynomial(Term{{1}, 1});
+
+        {
+            auto [quotients, remainder] = Divide(f1 * f2 + Polynomial(Term{{0, 0, 1}, 3}), std::vector{f1, f2});
+            EXPECT_EQUAL(quotients[0] * f1 + quotients[1] * f2 + remainder, f1 * f2 + Polynomial(Term{{0, 0, 1}, 3}));
+            EXPECT_EQUAL(remainder, Polynomial(Term{{0, 0, 1}, 3}));
+        }
+
+        PolynomialSet<> expected = {f1, f2};
+        BuhbergerAlgorithm(expected);
+
+        PolynomialSet<> set = {f1, f2};
+        CofactorTracker<Rational<>, LexicographicalOrder> tracker;
+        BuhbergerAlgorithm(set, tracker);
+
+        EXPECT_EQUAL(set, expected);
+        EXPECT_EQUAL(tracker.GetAmountOfGenerators(), 2ull);
+
+        std::vector<Polynomial<>> generators = {tracker.GetElement(0), tracker.GetElement(1)};
+        for (const auto &element : set) {
+            auto cofactors = tracker.GetCofactors(element);
+            EXPECT_EQUAL(cofactors.size(), 2ull);
+            EXPECT_EQUAL(cofactors[0] * generators[0] + cofactors[1] * generators[1], element);
+        }
+
+        EXPECT_THROW(tracker.AddGenerator(f1));
+        EXPECT_THROW(tracker.GetCofactors(f1 * f2));
+    }
+
+    void TestBatchEvaluation() {
+        Polynomial p({{{2, 1}, 3}, {{0, 3}, -1}, {{1}, Rational<>(1, 2)}, {{}, 5}});
+
+        BatchEvaluator<double> evaluator(p);
+        EXPECT_EQUAL(evaluator.GetAmountOfVariables(), 2ull);
+        EXPECT_EQUAL(evaluator.Evaluate({2, 1}), 12 - 1 + 1 + 5);
+        EXPECT_THROW(evaluator.Evaluate({2}));
+
+        std::vector<std::vector<double>> coordinates(2);
+        for (int point = 0; point < 150; ++point) {
+            coordinates[0].push_back(point % 7 - 3);
+            coordinates[1].push_back(point % 5);
+        }
+        auto values = evaluator.EvaluateBatch(coordinates);
+        EXPECT_EQUAL(values.size(), 150ull);
+        for (size_t point = 0; point < values.size(); ++point) {
+            double x = coordinates[0][point], y = coordinates[1][point];
+            EXPECT_EQUAL(values[point], 3 * x * x * y - y * y * y + x / 2 + 5);
+        }
+
+        using Field = Modular<1000003>;
+        Polynomial<Field> q({{{0, 2, 1}, 7}, {{3}, -2}, {{}, 1}});
+        BatchEvaluator<Field> modularEvaluator(q);
+        EXPECT_EQUAL(modularEvaluator.Evaluate({1000, 2, 3}), Field(7 * 4 * 3) - Field(2) * Field(1000) * 1000 * 1000 + 1);
+    }
+
+    void TestGF2() {
+        EXPECT_EQUAL(GF2(1) + GF2(1), GF2(0));
+        EXPECT_EQUAL(GF2(-1), GF2(1));
+        EXPECT_EQUAL(GF2(1) * GF2(0), GF2(0));
+        EXPECT_EQUAL(GF2(1) / GF2(1), GF2(1));
+        EXPECT_THROW(GF2(1) / GF2(0));
+
+        BitRow row(130);
+        EXPECT_EQUAL(row.FindFirst(), BitRow::npos);
+        row.Flip(129);
+        row.Flip(70);
+        EXPECT_EQUAL(row.FindFirst(), 70ull);
+        BitRow other(130);
+        other.Flip(70);
+        row.XorWith(other);
+        EXPECT_EQUAL(row.FindFirst(), 129ull);
+        EXPECT_TRUE(row.Test(129));
+
+        // The bit-packed FindPairs has to agree with the generic one over Z/2Z.
+        using Order = GradedReverseLexicographicalOrder;
+        std::vector<std::vector<Monomial>> generators = {
+            {{1, 1}, {0, 0, 2}, {1}},
+            {{0, 2, 1}, {1, 0, 1}, {}},
+            {{2}, {0, 1, 1}, {0, 0, 1}}
+        };
+
+        PolynomialSet<GF2, Order> packed;
+        PolynomialSet<Modular<2>, Order> generic;
+        for (const auto &monomials : generators) {
+            Polynomial<GF2, Order> packedPolynomial;
+            Polynomial<Modular<2>, Order> genericPolynomial;
+            for (const auto &monomial : monomials) {
+                packedPolynomial += Polynomial<GF2, Order>(monomial);
+                genericPolynomial += Polynomial<Modular<2>, Order>(monomial);
+            }
+            packed.insert(packedPolynomial);
+            generic.insert(genericPolynomial);
+        }
+
+        BuhbergerAlgorithm(packed);
+        BuhbergerAlgorithm(generic);
+
+        EXPECT_EQUAL(packed.size(), generic.size());
+        auto genericIter = generic.begin();
+        for (const auto &polynomial : packed) {
+            EXPECT_EQUAL(polynomial.GetAmountOfTerms(), genericIter->GetAmountOfTerms());
+            for (IndexType index = 0; index < polynomial.GetAmountOfTerms(); ++index) {
+                EXPECT_EQUAL(polynomial.GetNthTerm(index).first, genericIter->GetNthTerm(index).first);
+            }
+            ++genericIter;
+        }
+    }
+
+    void TestBoolean() {
+        BooleanMonomial xy{0, 1};
+        BooleanMonomial yz{1, 2};
+        EXPECT_EQUAL(xy * xy, xy);
+        EXPECT_EQUAL(xy * yz, BooleanMonomial({0, 1, 2}));
+        EXPECT_TRUE((xy * yz).IsDivisibleBy(xy));
+        EXPECT_FALSE(xy.IsDivisibleBy(yz));
+        EXPECT_EQUAL(BooleanMonomial({0, 1, 2}) / yz, BooleanMonomial{0});
+        EXPECT_EQUAL(BooleanMonomial({70}).GetAmountOfVariables(), 71ull);
+        EXPECT_TRUE(yz < xy);
+        EXPECT_EQUAL(BooleanMonomial(Monomial{3, 0, 2}), BooleanMonomial({0, 2}));
+
+        // (x + 1) * x = x^2 + x = 0 in the boolean ring.
+        BooleanPolynomial<> x{BooleanMonomial{0}};
+        EXPECT_TRUE(BooleanPolynomial<>::IsZero((x + BooleanMonomial()) * x));
+        EXPECT_TRUE(BooleanPolynomial<>::IsZero(x + x));
+
+        // Has to agree with the basis over Z/2Z with the field equations given explicitly.
+        using Order = GradedLexicographicalOrder;
+        using BooleanOrder = BooleanGradedLexicographicalOrder;
+        std::vector<std::vector<BooleanMonomial>> generators = {
+            {{0, 1}, {2}, {}},
+            {{1, 2}, {0, 3}},
+            {{0, 2, 3}, {1}, {3}}
+        };
+        const size_t amountOfVariables = 4;
+
+        BooleanPolynomialSet<BooleanOrder> booleanSet;
+        PolynomialSet<GF2, Order> explicitSet;
+        for (const auto &monomials : generators) {
+            BooleanPolynomial<BooleanOrder> polynomial;
+            for (const auto &monomial : monomials) {
+                polynomial += monomial;
+            }
+            booleanSet.insert(polynomial);
+            explicitSet.insert(polynomial.ToPolynomial<Order>());
+        }
+        for (size_t variable = 0; variable < amountOfVariables; ++variable) {
+            Monomial::DegreeVector square(variable + 1), linear(variable + 1);
+            square[variable] = 2;
+            linear[variable] = 1;
+            explicitSet.insert(Polynomial<GF2, Order>(Monomial(square)) + Polynomial<GF2, Order>(Monomial(linear)));
+        }
+
+        BuhbergerAlgorithm(booleanSet);
+        BuhbergerAlgorithm(explicitSet);
+
+        PolynomialSet<GF2, Order> converted;
+        for (const auto &polynomial : booleanSet) {
+            converted.insert(polynomial.ToPolynomial<Order>());
+        }
+        size_t amountOfSquarefree = 0;
+        for (const auto &polynomial : explicitSet) {
+            bool isSquarefree = true;
+            for (const auto &[monomial, coefficient] : polynomial) {
+                for (size_t variable = 0; variable < monomial.GetAmountOfVariables(); ++variable) {
+                    isSquarefree = isSquarefree && monomial.GetDegree(variable) < 2;
+                }
+            }
+            EXPECT_EQUAL(converted.contains(polynomial), isSquarefree);
+            amountOfSquarefree += isSquarefree;
+        }
+        EXPECT_EQUAL(converted.size(), amountOfSquarefree);
+    }
+
+    void TestGaloisField() {
+        // GF(4) has the only irreducible polynomial a^2 + a + 1.
+        using F4 = GaloisField<2, 2>;
+        F4 a = F4::GetGenerator();
+        EXPECT_EQUAL(a * a, a + 1);
+        EXPECT_EQUAL(a * a * a, F4(1));
+        EXPECT_EQUAL(a / (a + 1), a * a * a * a * a);
+        EXPECT_EQUAL(-a, a);
+        EXPECT_THROW(F4(1) / F4(0));
+
+        auto checkField = [] <typename Field> (Field generator, uint64_t order) {
+            Field element = 1;
+            for (int step = 0; step < 200; ++step) {
+                element = element * generator + Field(step);
+                if (element != Field(0)) {
+                    EXPECT_EQUAL(element * element.GetInverted(), Field(1));
+                    EXPECT_EQUAL(Field::Pow(element, order - 1), Field(1));
+                }
+                EXPECT_EQUAL((element + generator) * element, element * element + generator * element);
+                EXPECT_EQUAL(element - element, Field(0));
+            }
+        };
+        checkField(GaloisField<7, 3>::GetGenerator(), 343);
+        checkField(GaloisField<101, 3>::GetGenerator(), 1030301);
+        checkField(GaloisField<65537, 2>::GetGenerator(), 65537ull * 65537);
+
+        using F = GaloisField<101, 3>;
+        auto coordinates = F::GetDefiningPolynomial();
+        F root = F::GetGenerator();
+        F value = F::Pow(root, 3);
+        for (uint32_t power = 0; power < 3; ++power) {
+            value += F(coordinates[power]) * F::Pow(root, power);
+        }
+        EXPECT_EQUAL(value, F(0));
+
+        // Over GF(p) the tabulated field has to give the same basis as Modular<p>.
+        PolynomialSet<GaloisField<101, 1>> tabulated = {
+            Polynomial<GaloisField<101, 1>>({{{1, 1}, 3}, {{0, 0, 1}, -1}}),
+            Polynomial<GaloisField<101, 1>>({{{2}, 5}, {{0, 1}, 1}, {{}, 7}})
+        };
+        PolynomialSet<Modular<101>> modular = {
+            Polynomial<Modular<101>>({{{1, 1}, 3}, {{0, 0, 1}, -1}}),
+            Polynomial<Modular<101>>({{{2}, 5}, {{0, 1}, 1}, {{}, 7}})
+        };
+        BuhbergerAlgorithm(tabulated);
+        BuhbergerAlgorithm(modular);
+
+        EXPECT_EQUAL(tabulated.size(), modular.size());
+        auto modularIter = modular.begin();
+        for (const auto &polynomial : tabulated) {
+            EXPECT_EQUAL(polynomial.GetAmountOfTerms(), modularIter->GetAmountOfTerms());
+            for (IndexType index = 0; index < polynomial.GetAmountOfTerms(); ++index) {
+                EXPECT_EQUAL(polynomial.GetNthTerm(index).first, modularIter->GetNthTerm(index).first);
+                EXPECT_EQUAL(polynomial.GetNthTerm(index).second.GetCoordinates()[0],
+                             modularIter->GetNthTerm(index).second.GetValue());
+            }
+            ++modularIter;
+        }
+    }
+
+    void TestPAdicLifting() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+
+        // 35023 / 40009 is beyond the reconstruction bound sqrt(p / 2) of one digit.
+        PolynomialSet<Rational<>, Order> generators = {
+            PolynomialType({{{1}, 40009}, {{0, 1}, -35023}}),
+            PolynomialType({{{0, 2}, 1}, {{1}, Rational<>(1, 2)}, {{}, -3}}),
+            PolynomialType({{{0, 0, 1}, 1}, {{0, 1}, -1}, {{}, 1}})
+        };
+
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        PAdicLifting<Order> lifting(generators);
+        auto lifted = lifting.Lift();
+        EXPECT_TRUE(lifted.has_value());
+        EXPECT_EQUAL(*lifted, expected);
+        EXPECT_TRUE(lifting.GetPrecision() >= 2);
+
+        // The prime divides a denominator, the driver falls back to the plain algorithm.
+        PolynomialSet<Rational<>, Order> unlucky = {
+            PolynomialType({{{1, 1}, Rational<>(1, PAdicLifting<Order>::kPrime)}, {{0, 0, 1}, 1}}),
+            PolynomialType({{{2}, 1}, {{0, 1}, 1}})
+        };
+        EXPECT_FALSE(PAdicLifting<Order>(unlucky).Lift().has_value());
+
+        auto unluckyExpected = unlucky;
+        BuhbergerAlgorithm(unluckyExpected);
+        PAdicBuhbergerAlgorithm(unlucky);
+        EXPECT_EQUAL(unlucky, unluckyExpected);
+    }
+
+    void TestModularVerification() {
+        EXPECT_TRUE(ModularVerifier::IsPrime(2147483647));
+        EXPECT_FALSE(ModularVerifier::IsPrime(2147483649));
+        EXPECT_FALSE(ModularVerifier::IsPrime(1));
+
+        {
+            RuntimeModular::ModulusScope scope(7);
+            EXPECT_EQUAL(RuntimeModular(3) * RuntimeModular(5), RuntimeModular(1));
+            {
+                RuntimeModular::ModulusScope inner(11);
+                EXPECT_EQUAL(RuntimeModular(3) * RuntimeModular(4), RuntimeModular(1));
+            }
+            EXPECT_EQUAL(RuntimeModular::GetCurrentModulus(), 7u);
+        }
+
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+        PolynomialSet<Rational<>, Order> generators = {
+            PolynomialType({{{1, 1}, 2}, {{0, 0, 1}, -1}}),
+            PolynomialType({{{2}, Rational<>(1, 3)}, {{0, 1}, 1}, {{}, -1}})
+        };
+        auto basis = generators;
+        BuhbergerAlgorithm(basis);
+
+        ModularVerificationOptions options;
+        options.seed = 42;
+        options.amountOfThreads = 2;
+        ModularVerifier verifier(options);
+        EXPECT_TRUE(verifier.Verify(basis, generators));
+        EXPECT_EQUAL(verifier.GetPrimes().size(), verifier.GetAmountOfPrimes());
+
+        // A perturbed coefficient leaves the ideal, a missing element breaks the Gröbner property,
+        // and the generators themselves are not a Gröbner basis.
+        auto perturbed = basis;
+        auto element = *perturbed.rbegin();
+        perturbed.erase(element);
+        perturbed.insert(element + PolynomialType(Rational<>(1, 5)));
+        EXPECT_FALSE(verifier.Verify(perturbed, generators));
+
+        auto incomplete = basis;
+        incomplete.erase(incomplete.begin());
+        EXPECT_FALSE(verifier.Verify(incomplete, generators));
+        EXPECT_FALSE(VerifyModularly(generators, generators, options));
+    }
+
+    void TestIsGroebnerBasis() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Modular<101>, Order>;
+
+        PolynomialSet<Modular<101>, Order> generators = {
+            PolynomialType({{{1, 1}, 2}, {{0, 0, 1}, -1}}),
+            PolynomialType({{{2}, 3}, {{0, 1}, 1}, {{}, -1}}),
+            PolynomialType({{{0, 2, 1}, 1}, {{1}, 5}})
+        };
+        EXPECT_FALSE(IsGroebnerBasis(generators, 4));
+
+        auto basis = generators;
+        BuhbergerAlgorithm(basis);
+        EXPECT_TRUE(IsGroebnerBasis(basis, 4));
+        EXPECT_TRUE(IsGroebnerBasis(basis, 1));
+
+        // Not reduced, still a Gröbner basis.
+        basis.insert(*basis.begin() * PolynomialType(Monomial{0, 1}) + *basis.rbegin());
+        EXPECT_TRUE(IsGroebnerBasis(basis, 4));
+
+        EXPECT_TRUE(IsGroebnerBasis(PolynomialSet<Modular<101>, Order>()));
+
+        // Workers inherit the thread-local modulus.
+        RuntimeModular::ModulusScope scope(101);
+        PolynomialSet<RuntimeModular, Order> runtimeBasis;
+        for (const auto &polynomial : basis) {
+            Polynomial<RuntimeModular, Order> image;
+            for (const auto &[monomial, coefficient] : polynomial) {
+                image.PushBackTerm(monomial, coefficient.GetValue());
+            }
+            runtimeBasis.insert(image);
+        }
+        EXPECT_TRUE(IsGroebnerBasis(runtimeBasis, 4));
+    }
+
+    void TestModularPreFilter() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+
+        PolynomialSet<Rational<>, Order> generators = {
+            PolynomialType({{{1, 1}, 2}, {{0, 0, 1}, -1}}),
+            PolynomialType({{{2}, Rational<>(1, 3)}, {{0, 1}, 1}, {{}, -1}}),
+            PolynomialType({{{0, 2}, 1}, {{0, 0, 1}, Rational<>(-1, 2)}})
+        };
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        BuchbergerOptions options;
+        options.useModularPreFilter = true;
+        options.seed = 42;
+        auto filtered = generators;
+        BuhbergerAlgorithm(filtered, options);
+        EXPECT_EQUAL(filtered, expected);
+
+        // On a Gröbner basis every S-pair reduces to zero, on the generators not every one does.
+        ModularPreFilter<Order> basisFilter(expected, 1000000007);
+        EXPECT_TRUE(basisFilter.IsUsable());
+        for (const auto &first : expected) {
+            for (const auto &second : expected) {
+                EXPECT_TRUE(basisFilter.ReducesToZero(first, second));
+            }
+        }
+
+        ModularPreFilter<Order> generatorsFilter(generators, 1000000007);
+        bool isAnyNonZero = false;
+        for (const auto &first : generators) {
+            for (const auto &second : generators) {
+                isAnyNonZero |= !generatorsFilter.ReducesToZero(first, second);
+            }
+        }
+        EXPECT_TRUE(isAnyNonZero);
+
+        // The prime 3 divides a denominator, the filter then never skips a pair.
+        ModularPreFilter<Order> unusableFilter(generators, 3);
+        EXPECT_FALSE(unusableFilter.IsUsable());
+        EXPECT_FALSE(unusableFilter.ReducesToZero(*generators.begin(), *generators.rbegin()));
+    }
+
+    void TestLinearElimination() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+
+        PolynomialSet<Rational<>, Order> generators = {
+            PolynomialType({{{1}, 1}, {{0, 1}, 1}, {{0, 0, 1}, -1}, {{}, -1}}),
+            PolynomialType({{{0, 1}, 2}, {{0, 0, 0, 1}, -1}}),
+            PolynomialType({{{1, 0, 1}, 1}, {{0, 0, 0, 2}, -1}}),
+            PolynomialType({{{0, 0, 2}, 1}, {{0, 0, 0, 1}, 1}, {{}, -3}})
+        };
+
+        LinearElimination<Rational<>, Order> elimination(generators);
+        EXPECT_EQUAL(elimination.GetAmountOfEliminatedVariables(), 2u);
+        for (const auto &row : elimination.GetLinearPart()) {
+            for (const auto &polynomial : elimination.GetRemainingPart()) {
+                for (const auto &[monomial, coefficient] : polynomial) {
+                    EXPECT_FALSE(monomial.IsDivisibleBy(row.GetLeadingTerm().first));
+                }
+            }
+        }
+
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        BuchbergerOptions options;
+        options.eliminateLinearEquations = true;
+        auto eliminated = generators;
+        BuhbergerAlgorithm(eliminated, options);
+        EXPECT_EQUAL(eliminated, expected);
+
+        // x_0^2 - x_1^2 + x_2 turns linear once x_0 = x_1 is substituted.
+        PolynomialSet<Rational<>, Order> cascading = {
+            PolynomialType({{{1}, 1}, {{0, 1}, -1}}),
+            PolynomialType({{{2}, 1}, {{0, 2}, -1}, {{0, 0, 1}, 1}}),
+            PolynomialType({{{0, 1, 1}, 1}, {{0, 2}, 1}, {{}, -4}})
+        };
+        using Elimination = LinearElimination<Rational<>, Order>;
+        EXPECT_EQUAL(Elimination(cascading).GetAmountOfEliminatedVariables(), 2u);
+        expected = cascading;
+        BuhbergerAlgorithm(expected);
+        BuhbergerAlgorithm(cascading, options);
+        EXPECT_EQUAL(cascading, expected);
+
+        PolynomialSet<Rational<>, Order> inconsistent = {
+            PolynomialType({{{1}, 1}, {{0, 1}, 1}}),
+            PolynomialType({{{1}, 2}, {{0, 1}, 2}, {{}, -1}}),
+            PolynomialType({{{0, 2}, 1}, {{}, -1}})
+        };
+        EXPECT_TRUE(Elimination(inconsistent).IsInconsistent());
+        BuhbergerAlgorithm(inconsistent, options);
+        EXPECT_EQUAL(inconsistent, (PolynomialSet<Rational<>, Order>{PolynomialType(1)}));
+    }
+
+    void TestComponentDecomposition() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Modular<101>, Order>;
+
+        // {x_0, x_2} and {x_1, x_3, x_4} are disjoint, x_5 stands alone.
+        PolynomialSet<Modular<101>, Order> generators = {
+            PolynomialType({{{1, 0, 1}, 2}, {{}, -1}}),
+            PolynomialType({{{2}, 1}, {{0, 0, 1}, 3}}),
+            PolynomialType({{{0, 1, 0, 1}, 1}, {{0, 0, 0, 0, 2}, -1}}),
+            PolynomialType({{{0, 2}, 1}, {{0, 0, 0, 1}, 5}}),
+            PolynomialType({{{0, 0, 0, 0, 1}, 1}, {{0, 1}, 1}, {{}, 1}}),
+            PolynomialType({{{0, 0, 0, 0, 0, 3}, 1}, {{}, 7}})
+        };
+        EXPECT_EQUAL(SplitIntoComponents(generators).size(), 3u);
+
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        BuchbergerOptions options;
+        options.decomposeComponents = true;
+        options.amountOfThreads = 2;
+        auto decomposed = generators;
+        BuhbergerAlgorithm(decomposed, options);
+        EXPECT_EQUAL(decomposed, expected);
+
+        // A contradicting component makes the whole ideal trivial.
+        generators.insert(PolynomialType({{{0, 0, 0, 0, 0, 0, 1}, 1}}));
+        generators.insert(PolynomialType({{{0, 0, 0, 0, 0, 0, 1}, 1}, {{}, 1}}));
+        EXPECT_EQUAL(SplitIntoComponents(generators).size(), 4u);
+        BuhbergerAlgorithm(generators, options);
+        EXPECT_EQUAL(generators, (PolynomialSet<Modular<101>, Order>{PolynomialType(1)}));
+    }
+
+    void TestInputNormalization() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+
+        EXPECT_EQUAL(Gcd(Monomial({2, 1, 3}), Monomial({1, 4})), Monomial({1, 1}));
+        EXPECT_EQUAL(GetMonomialContent(PolynomialType({{{2, 1}, 1}, {{1, 3}, 5}})), Monomial({1, 1}));
+        EXPECT_EQUAL(StripContent(PolynomialType({{{2}, Rational<>(-1, 2)}, {{0, 1}, Rational<>(1, 3)}})),
+                     PolynomialType({{{2}, 3}, {{0, 1}, -2}}));
+
+        PolynomialSet<Rational<>, Order> generators = {
+            PolynomialType({{{1, 2}, 2}, {{1, 1}, -4}}),
+            PolynomialType({{{2, 1}, 6}, {{1, 1, 1}, Rational<>(1, 2)}}),
+            PolynomialType({{{1, 1, 2}, 3}, {{1, 1}, -12}})
+        };
+        auto normalized = generators;
+        EXPECT_EQUAL(NormalizeGenerators(normalized), Monomial({1, 1}));
+        EXPECT_TRUE(normalized.contains(PolynomialType({{{0, 1}, 1}, {{}, -2}})));
+        EXPECT_TRUE(normalized.contains(PolynomialType({{{1}, 12}, {{0, 0, 1}, 1}})));
+
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        BuchbergerOptions options;
+        options.normalizeGenerators = true;
+        BuhbergerAlgorithm(generators, options);
+        EXPECT_EQUAL(generators, expected);
+
+        // (x_0 x_1 - x_0, x_0^2 - x_0) : x_0^∞ = (x_1 - 1, x_0 - 1).
+        using ModularPolynomial = Polynomial<Modular<101>, Order>;
+        PolynomialSet<Modular<101>, Order> saturated = {
+            ModularPolynomial({{{1, 1}, 1}, {{1}, -1}}),
+            ModularPolynomial({{{2}, 1}, {{1}, -1}})
+        };
+        options.saturateMonomialFactors = true;
+        BuhbergerAlgorithm(saturated, options);
+        EXPECT_EQUAL(saturated, (PolynomialSet<Modular<101>, Order>{
+            ModularPolynomial({{{0, 1}, 1}, {{}, -1}}),
+            ModularPolynomial({{{1}, 1}, {{}, -1}})
+        }));
+    }
+
+    void TestStrategySelector() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+
+        PolynomialSet<Rational<>, Order> generators = {
+            PolynomialType({{{1}, 1}, {{0, 1}, Rational<>(1, 2)}, {{}, -1}}),
+            PolynomialType({{{0, 2}, 1}, {{0, 1}, 1}, {{}, -6}}),
+            PolynomialType({{{0, 0, 2}, 3}, {{}, -27}})
+        };
+
+        auto features = AnalyzeInput(generators);
+        EXPECT_EQUAL(features.amountOfGenerators, 3u);
+        EXPECT_EQUAL(features.amountOfVariables, 3u);
+        EXPECT_EQUAL(features.maxDegree, 2u);
+        EXPECT_EQUAL(features.amountOfTerms, 8u);
+        EXPECT_EQUAL(features.amountOfLinearGenerators, 1u);
+        EXPECT_EQUAL(features.amountOfComponents, 2u);
+        EXPECT_EQUAL(features.maxCoefficientBits, 5u);
+        EXPECT_FALSE(features.isHomogeneous);
+        EXPECT_FALSE(features.hasCommonMonomialFactor);
+
+        auto decision = StrategySelector::Select<Rational<>>(features);
+        EXPECT_TRUE(decision.options.eliminateLinearEquations);
+        EXPECT_TRUE(decision.options.decomposeComponents);
+        EXPECT_FALSE(decision.options.usePAdicLifting);
+
+        features.amountOfVariables = features.amountOfGenerators = 4;
+        EXPECT_TRUE(StrategySelector::Select<Rational<>>(features).options.usePAdicLifting);
+        EXPECT_FALSE(StrategySelector::Select<Modular<101>>(features).options.usePAdicLifting);
+
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        std::ostringstream log;
+        auto basis = generators;
+        AutoBuhbergerAlgorithm(basis, &log);
+        EXPECT_EQUAL(basis, expected);
+        EXPECT_TRUE(log.str().find("linear elimination") != std::string::npos);
+    }
+
+    void TestReducerSelection() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+
+        // Both divisors reduce x_0^2 x_1, the second one is shorter and has smaller coefficients.
+        PolynomialType longer({{{1, 1}, 1}, {{1}, Rational<>(7, 3)}, {{0, 1}, 5}, {{}, -11}});
+        PolynomialType shorter({{{2}, 1}, {{}, -1}});
+        std::vector<PolynomialType> divisors = {longer, shorter};
+        PolynomialType dividend({{{2, 1}, 1}});
+
+        for (auto selection : {ReducerSelection::kFirst, ReducerSelection::kShortest, ReducerSelection::kLowestSugar,
+                               ReducerSelection::kSmallestCoefficients, ReducerSelection::kMostRecent}) {
+            HeapDivision<Rational<>, Order> division(divisors, selection);
+            auto remainder = division.Reduce(dividend);
+            auto quotients = division.GetQuotients();
+            EXPECT_EQUAL(quotients[0] * longer + quotients[1] * shorter + remainder, dividend);
+
+            bool isFirst = selection == ReducerSelection::kFirst || selection == ReducerSelection::kLowestSugar;
+            EXPECT_EQUAL(PolynomialType::IsZero(quotients[0]), !isFirst);
+            EXPECT_EQUAL(division.GetStatistics().redirectedReductions > 0, !isFirst);
+        }
+
+        PolynomialSet<Rational<>, Order> generators = {
+            PolynomialType({{{1, 1}, 2}, {{0, 0, 1}, -1}}),
+            PolynomialType({{{2}, Rational<>(1, 3)}, {{0, 1}, 1}, {{}, -1}}),
+            PolynomialType({{{0, 2}, 1}, {{0, 0, 1}, Rational<>(-1, 2)}})
+        };
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        for (auto selection : {ReducerSelection::kShortest, ReducerSelection::kLowestSugar,
+                               ReducerSelection::kSmallestCoefficients, ReducerSelection::kMostRecent}) {
+            ReductionStatistics statistics;
+            BuchbergerOptions options;
+            options.reducerSelection = selection;
+            options.statistics = &statistics;
+
+            auto basis = generators;
+            BuhbergerAlgorithm(basis, options);
+            EXPECT_EQUAL(basis, expected);
+            EXPECT_TRUE(statistics.reductions > 0);
+            EXPECT_TRUE(statistics.ambiguousReductions >= statistics.redirectedReductions);
+        }
+    }
+
+    void TestMonomialMultipleCache() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Modular<101>, Order>;
+
+        PolynomialSet<Modular<101>, Order> basis = {
+            PolynomialType({{{1, 1}, 1}, {{0, 2}, 3}, {{}, -1}}),
+            PolynomialType({{{0, 3}, 1}, {{1}, 1}})
+        };
+        const auto &element = *basis.begin();
+
+        MonomialMultipleCache<Modular<101>, Order> cache(100);
+        EXPECT_EQUAL(cache.Multiply(element, Monomial({1}), basis), PolynomialType({{{1}, 1}}) * element);
+        EXPECT_EQUAL(cache.Multiply(element, Monomial({1}), basis), PolynomialType({{{1}, 1}}) * element);
+        EXPECT_EQUAL(cache.GetStatistics().hits, 1u);
+        EXPECT_EQUAL(cache.GetStatistics().misses, 1u);
+        EXPECT_EQUAL(cache.GetStoredTerms(), 3u);
+
+        // Three products of three terms do not fit into a limit of eight.
+        MonomialMultipleCache<Modular<101>, Order> bounded(8);
+        for (auto multiplier : {Monomial({1}), Monomial({0, 1}), Monomial({2})}) {
+            bounded.Multiply(element, multiplier, basis);
+        }
+        EXPECT_EQUAL(bounded.GetStatistics().evictions, 1u);
+        EXPECT_TRUE(bounded.GetStoredTerms() <= 8u);
+
+        // A simplified multiple keeps the leading term and differs from m * g by an ideal element.
+        MonomialMultipleCache<Modular<101>, Order> simplifying(100, true);
+        simplifying.Multiply(element, Monomial({0, 1}), basis);
+        auto product = simplifying.Multiply(element, Monomial({1, 1}), basis);
+        EXPECT_EQUAL(simplifying.GetStatistics().simplifiedHits, 1u);
+        EXPECT_EQUAL(product.GetLeadingTerm(), (PolynomialType({{{1, 1}, 1}}) * element).GetLeadingTerm());
+
+        PolynomialSet<Modular<101>, Order> generators = {
+            PolynomialType({{{1, 1}, 2}, {{0, 0, 1}, -1}}),
+            PolynomialType({{{2}, 3}, {{0, 1}, 1}, {{}, -1}}),
+            PolynomialType({{{0, 2, 1}, 1}, {{1}, 5}})
+        };
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        for (bool isSimplifying : {false, true}) {
+            MultipleCacheStatistics statistics;
+            BuchbergerOptions options;
+            options.multipleCacheTerms = 1000;
+            options.simplifyMultiples = isSimplifying;
+            options.multipleCacheStatistics = &statistics;
+
+            auto result = generators;
+            BuhbergerAlgorithm(result, options);
+            EXPECT_EQUAL(result, expected);
+            EXPECT_TRUE(statistics.GetHitRate() > 0);
+        }
+    }
+
+    void TestParallelInterreduction() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+
+        PolynomialSet<Rational<>, Order> generators = {
+            PolynomialType({{{1, 1}, 2}, {{0, 0, 1}, -1}}),
+            PolynomialType({{{2}, 3}, {{0, 1}, 1}, {{}, -1}}),
+            PolynomialType({{{0, 2, 1}, 1}, {{1}, 5}})
+        };
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        // A redundant element, a scaled one and tails reducible by the others.
+        auto basis = expected;
+        basis.insert(*basis.begin() * PolynomialType(Monomial{0, 1}) + *basis.rbegin());
+        basis.insert(*basis.begin() * PolynomialType(Rational<>(3)) + *std::next(basis.begin()));
+        basis.insert(PolynomialType(0));
+        for (size_t amountOfThreads : {1u, 4u}) {
+            auto result = basis;
+            ParallelInterreduction(result, amountOfThreads);
+            EXPECT_EQUAL(result, expected);
+        }
+
+        BuchbergerOptions options;
+        options.parallelInterreduction = true;
+        options.amountOfThreads = 4;
+        auto result = generators;
+        BuhbergerAlgorithm(result, options);
+        EXPECT_EQUAL(result, expected);
+    }
+
+    void TestConcurrentBasis() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Modular<101>, Order>;
+
+        ConcurrentBasis<Modular<101>, Order> basis;
+        EXPECT_EQUAL(basis.Append(PolynomialType({{{1, 1}, 2}, {{0, 0, 1}, -1}})), 0u);
+        EXPECT_EQUAL(basis.Append(PolynomialType({{{2}, 3}, {{0, 1}, 1}})), 1u);
+        EXPECT_EQUAL(basis.GetSize(), 2u);
+        EXPECT_EQUAL(basis.FindReducer(Monomial{2, 1}, 2), 0u);
+        EXPECT_EQUAL(basis.FindReducer(Monomial{0, 3}, 2), 2u);
+
+        {
+            // The replaced element stays alive while a reader may hold it.
+            ConcurrentBasis<Modular<101>, Order>::ReadGuard guard(basis);
+            const auto &old = basis.Get(1, guard);
+            basis.Replace(1, PolynomialType({{{2}, 1}}));
+            EXPECT_EQUAL(old, PolynomialType({{{2}, 3}, {{0, 1}, 1}}));
+            EXPECT_EQUAL(basis.GetRetiredCount(), 1u);
+        }
+        basis.Replace(1, PolynomialType({{{2}, 1}, {{1}, 1}}));
+        EXPECT_EQUAL(basis.GetRetiredCount(), 0u);
+        EXPECT_THROW(basis.Replace(0, PolynomialType({{{2}, 1}})));
+
+        // Readers see a consistent prefix while the basis grows over several chunks.
+        std::atomic<bool> isDone = false;
+        std::thread reader([&] {
+            while (!isDone) {
+                size_t size = basis.GetSize();
+                auto elements = basis.Snapshot(size);
+                for (size_t index = 2; index < size; ++index) {
+                    EXPECT_EQUAL(elements[index], PolynomialType({{{0, index}, 1}}));
+                    EXPECT_EQUAL(basis.GetLeadingMonomial(index), Monomial({0, index}));
+                }
+            }
+        });
+        for (size_t index = 2; index < 500; ++index) {
+            basis.Append(PolynomialType({{{0, index}, 1}}));
+        }
+        isDone = true;
+        reader.join();
+        EXPECT_EQUAL(basis.GetSize(), 500u);
+
+        PolynomialSet<Modular<101>, Order> generators = {
+            PolynomialType({{{1, 1}, 2}, {{0, 0, 1}, -1}}),
+            PolynomialType({{{2}, 3}, {{0, 1}, 1}, {{}, -1}}),
+            PolynomialType({{{0, 2, 1}, 1}, {{1}, 5}})
+        };
+        auto expected = generators;
+        BuhbergerAlgorithm(expected);
+
+        for (size_t amountOfThreads : {1u, 4u}) {
+            ReductionStatistics statistics;
+            BuchbergerOptions options;
+            options.useConcurrentBasis = true;
+            options.amountOfThreads = amountOfThreads;
+            options.statistics = &statistics;
+
+            auto result = generators;
+            BuhbergerAlgorithm(result, options);
+            EXPECT_EQUAL(result, expected);
+            EXPECT_TRUE(statistics.reductions > 0);
+        }
+    }
+
+    void TestTermStreams() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+        using Stream = PolynomialTermStream<Rational<>, Order>;
+
+        PolynomialType f({{{1, 1}, 2}, {{0, 0, 1}, -1}, {{}, 3}});
+        PolynomialType g({{{2}, 3}, {{0, 1}, 1}, {{}, -1}});
+
+        EXPECT_EQUAL(Collect(Stream(f)), f);
+        EXPECT_EQUAL(Collect(Stream(PolynomialType())), PolynomialType());
+        EXPECT_EQUAL(Collect(ScaledTermStream(Stream(f), Monomial{0, 2}, Rational<>(-2))),
+                     PolynomialType({{{0, 2}, -2}}) * f);
+        EXPECT_EQUAL(Collect(ScaledTermStream(Stream(f), Monomial{1}, Rational<>(0))), PolynomialType());
+        EXPECT_EQUAL(Collect(SumTermStream(Stream(f), Stream(g))), f + g);
+
+        // Terms cancelling to zero are skipped, not yielded.
+        auto difference = SumTermStream(Stream(f), ScaledTermStream(Stream(f), Monomial(), Rational<>(-1)));
+        EXPECT_TRUE(difference.IsEnd());
+
+        EXPECT_EQUAL(Collect(SPolynomialStream(f, g)), SPolynomial(f, g));
+
+        PolynomialSet<Rational<>, Order> divisors = {
+            PolynomialType({{{0, 1}, 1}, {{}, -1}}),
+            PolynomialType({{{0, 0, 1}, 2}, {{1}, 1}})
+        };
+        EXPECT_EQUAL(HeapReduction(SPolynomialStream(f, g), divisors), HeapReduction(SPolynomial(f, g), divisors));
+    }
+
+    void TestBinomialEngine() {
+        PackedMonomial a(Monomial{3, 0, 2, 0, 1}, 5);
+        PackedMonomial b(Monomial{1, 4, 2}, 5);
+        EXPECT_EQUAL(a.ToMonomial(), Monomial({3, 0, 2, 0, 1}));
+        EXPECT_EQUAL((a * b).ToMonomial(), Monomial({4, 4, 4, 0, 1}));
+        EXPECT_EQUAL(Lcm(a, b).ToMonomial(), Monomial({3, 4, 2, 0, 1}));
+        EXPECT_EQUAL(Lcm(a, b).TotalDegree(), 10u);
+        EXPECT_TRUE((a * b).IsDivisibleBy(b));
+        EXPECT_FALSE(a.IsDivisibleBy(b));
+        EXPECT_EQUAL((a * b / b), a);
+        EXPECT_THROW(PackedMonomial(Monomial{1 << 15}, 1));
+
+        for (auto [lhs, rhs] : {std::pair{Monomial{2, 1}, Monomial{1, 2, 1}}, {Monomial{0, 0, 3}, Monomial{1, 1}}}) {
+            PackedMonomial packedLhs(lhs, 3), packedRhs(rhs, 3);
+            EXPECT_EQUAL(PackedOrder<LexicographicalOrder>()(packedLhs, packedRhs), LexicographicalOrder()(lhs, rhs));
+            EXPECT_EQUAL(PackedOrder<GradedReverseLexicographicalOrder>()(packedLhs, packedRhs),
+                         GradedReverseLexicographicalOrder()(lhs, rhs));
+            EXPECT_EQUAL(PackedOrder<GradedReverseLexicographicalOrder>()(packedRhs, packedLhs),
+                         GradedReverseLexicographicalOrder()(rhs, lhs));
+        }
+
+        // Toric ideal of the twisted cubic, a lattice ideal with a coefficient and a monomial.
+        auto check = [] <typename FieldType, typename Order> (std::type_identity<FieldType>, std::type_identity<Order>) {
+            using PolynomialType = Polynomial<FieldType, Order>;
+            std::vector<PolynomialSet<FieldType, Order>> inputs = {
+                {
+                    PolynomialType({{{0, 2}, 1}, {{1, 0, 1}, -1}}),
+                    PolynomialType({{{1, 0, 1}, 1}, {{0, 1, 0, 1}, -1}}),
+                    PolynomialType({{{0, 0, 2}, 1}, {{0, 1, 0, 1}, -1}})
+                },
+                {
+                    PolynomialType({{{3, 1}, 1}, {{0, 0, 2}, 2}}),
+                    PolynomialType({{{1, 2}, 1}, {{0, 0, 0, 1}, -3}}),
+                    PolynomialType({{{0, 0, 1, 2}, 1}}),
+                    PolynomialType({{{2}, 1}, {{0, 1}, -1}})
+                }
+            };
+            for (const auto &input : inputs) {
+                auto expected = input;
+                BuhbergerAlgorithm(expected);
+
+                auto result = input;
+                BinomialBuhbergerAlgorithm(result);
+                EXPECT_EQUAL(result, expected);
+
+                BuchbergerOptions options;
+                options.useBinomialEngine = true;
+                result = input;
+                BuhbergerAlgorithm(result, options);
+                EXPECT_EQUAL(result, expected);
+            }
+        };
+        check(std::type_identity<Rational<>>(), std::type_identity<GradedReverseLexicographicalOrder>());
+        check(std::type_identity<Rational<>>(), std::type_identity<LexicographicalOrder>());
+        check(std::type_identity<Modular<101>>(), std::type_identity<GradedLexicographicalOrder>());
+
+        using PolynomialType = Polynomial<Rational<>, GradedReverseLexicographicalOrder>;
+        PolynomialSet<Rational<>, GradedReverseLexicographicalOrder> trinomial = {
+            PolynomialType({{{2}, 1}, {{0, 1}, 1}, {{}, 1}})
+        };
+        EXPECT_THROW(BinomialBuhbergerAlgorithm(trinomial));
+        EXPECT_TRUE(AnalyzeInput(PolynomialSet<Rational<>, GradedReverseLexicographicalOrder>{
+            PolynomialType({{{2}, 1}, {{0, 1}, -1}})
+        }).isBinomial);
+        EXPECT_FALSE(AnalyzeInput(trinomial).isBinomial);
+    }
+
+    void TestDenseArithmetic() {
+        using Order = GradedReverseLexicographicalOrder;
+        using PolynomialType = Polynomial<Rational<>, Order>;
+        using DenseType = DensePolynomial<Rational<>, Order>;
+
+        PolynomialType f({{{2, 1}, 1}, {{1, 2}, 3}, {{0, 1}, -5}, {{}, 7}});
+        PolynomialType g({{{0, 0, 1}, 2}, {{1}, -1}});
+        DenseType denseF(f);
+        EXPECT_EQUAL(DenseType::GetExtents(f), DenseType::Extents({3, 3}));
+        EXPECT_EQUAL(denseF.ToPolynomial(), f);
+        EXPECT_EQUAL(DenseType(f, {4, 5, 2}).ToPolynomial(), f);
+        EXPECT_THROW(DenseType(f, {2, 3}));
+        EXPECT_EQUAL((denseF * denseF * denseF).ToPolynomial(), f * f * f);
+        EXPECT_EQUAL((denseF * DenseType(g)).ToPolynomial(), f * g);
+
+        // x_0 - x_1^5 under lex moves every reduced term out of the box of the dividend, and
+        // x_0^1200 x_1^1200 does not fit into any box.
+        auto checkReduction = [] <typename Ordering> (std::type_identity<Ordering>,
+                                                      const std::vector<Polynomial<Rational<>, Ordering>> &divisors,
+                                                      const Polynomial<Rational<>, Ordering> &dividend) {
+            size_t reductionCount = 0;
+            auto remainder = DenseReduction(dividend, divisors, &reductionCount);
+            EXPECT_EQUAL(remainder, HeapReduction(dividend, divisors));
+            EXPECT_TRUE(reductionCount > 0);
+        };
+        using LexPolynomial = Polynomial<Rational<>, LexicographicalOrder>;
+        checkReduction(std::type_identity<LexicographicalOrder>(),
+                       {LexPolynomial({{{1}, 1}, {{0, 5}, -1}})},
+                       LexPolynomial({{{3}, 1}, {{1, 1}, 1}}));
+        checkReduction(std::type_identity<LexicographicalOrder>(),
+                       {LexPolynomial({{{1}, 1}, {{0, 5}, -1}}), LexPolynomial({{{0, 7}, 1}, {{}, -1}})},
+                       LexPolynomial({{{3}, 1}, {{1, 1}, 1}, {{0, 2}, 4}}));
+        checkReduction(std::type_identity<Order>(), {f, g}, f * f * f + PolynomialType({{{0, 4}, 1}}));
+        checkReduction(std::type_identity<Order>(),
+                       {PolynomialType({{{0, 1}, 1}, {{}, -1}})},
+                       PolynomialType({{{1200, 1200}, 1}}));
+        // The tail of the reducer uses a variable the dividend does not have.
+        checkReduction(std::type_identity<LexicographicalOrder>(),
+                       {LexPolynomial({{{2}, 1}, {{0, 1}, 1}})},
+                       LexPolynomial({{{3}, 1}}));
+        checkReduction(std::type_identity<Order>(),
+                       {PolynomialType({{{1, 1}, 1}, {{0, 0, 0, 1}, 3}})},
+                       PolynomialType({{{2, 2}, 1}, {{}, 1}}));
+
+        // Random bivariate systems, where reducers keep leaving the box of the S-polynomial.
+        auto checkRandom = [] <typename Ordering> (std::type_identity<Ordering>) {
+            using RandomPolynomial = Polynomial<Modular<32003>, Ordering>;
+            std::mt19937 generator(17);
+            for (size_t round = 0; round < 20; ++round) {
+                PolynomialSet<Modular<32003>, Ordering> input;
+                while (input.size() < 3) {
+                    RandomPolynomial polynomial;
+                    for (size_t term = 0; term < 3; ++term) {
+                        Monomial::DegreeVector degrees = {generator() % 4, generator() % 4};
+                        polynomial += RandomPolynomial({{Monomial(std::move(degrees)),
+                                                         static_cast<int>(generator() % 7) - 3}});
+                    }
+                    if (!RandomPolynomial::IsZero(polynomial)) {
+                        input.insert(polynomial);
+                    }
+                }
+
+                auto expected = input;
+                BuhbergerAlgorithm(expected);
+                BuchbergerOptions options;
+                options.useDenseArithmetic = true;
+                auto result = input;
+                BuhbergerAlgorithm(result, options);
+                EXPECT_EQUAL(result, expected);
+            }
+        };
+        checkRandom(std::type_identity<LexicographicalOrder>());
+        checkRandom(std::type_identity<GradedLexicographicalOrder>());
+        checkRandom(std::type_identity<Order>());
+
+        auto check = [] <typename FieldType> (std::type_identity<FieldType>) {
+            using CheckedPolynomial = Polynomial<FieldType, Order>;
+            PolynomialSet<FieldType, Order> input = {
+                CheckedPolynomial({{{2}, 1}, {{1, 1}, 1}, {{0, 2}, 1}, {{}, -1}}),
+                CheckedPolynomial({{{3}, 1}, {{0, 2}, -1}, {{1}, 2}})
+            };
+            auto expected = input;
+            BuhbergerAlgorithm(expected);
+
+            BuchbergerOptions options;
+            options.useDenseArithmetic = true;
+            auto result = input;
+            BuhbergerAlgorithm(result, options);
+            EXPECT_EQUAL(result, expected);
+
+            PolynomialSet<FieldType, Order> crossing = {
+                CheckedPolynomial({{{3}, 1}, {{}, -1}}),
+                CheckedPolynomial({{{2}, 1}, {{0, 1}, 1}}),
+                CheckedPolynomial({{{3}, 1}, {{2}, 1}})
+            };
+            auto crossingExpected = crossing;
+            BuhbergerAlgorithm(crossingExpected);
+            auto crossingResult = crossing;
+            BuhbergerAlgorithm(crossingResult, options);
+            EXPECT_EQUAL(crossingResult, crossingExpected);
+
+            auto features = AnalyzeInput(input);
+            EXPECT_TRUE(StrategySelector::Select<FieldType>(features).options.useDenseArithmetic);
+            features.amountOfVariables = 3;
+            EXPECT_FALSE(StrategySelector::Select<FieldType>(features).options.useDenseArithmetic);
+
+            std::ostringstream log;
+            result = input;
+            AutoBuhbergerAlgorithm(result, &log);
+            EXPECT_EQUAL(result, expected);
+            EXPECT_TRUE(log.str().find("arithmetic: dense") != std::string::npos);
+        };
+        check(std::type_identity<Rational<>>());
+        check(std::type_identity<Modular<101>>());
+    }
+
     void TestAll() {
         TestRational();
         TestOverflow();
         TestMonomial();
         TestPolynomial();
         TestOrder();
+        TestModular();
+        TestKroneckerMultiplication();
         TestAlgorithms();
+        TestHeapDivision();
+        TestCofactors();
+        TestBatchEvaluation();
+        TestGF2();
+        TestBoolean();
+        TestGaloisField();
+        TestPAdicLifting();
+        TestModularVerification();
+        TestIsGroebnerBasis();
+        TestModularPreFilter();
+        TestLinearElimination();
+        TestComponentDecomposition();
+        TestInputNormalization();
+        TestStrategySelector();
+        TestReducerSelection();
+        TestMonomialMultipleCache();
+        TestParallelInterreduction();
+        TestConcurrentBasis();
+        TestTermStreams();
+        TestBinomialEngine();
+        TestDenseArithmetic();
     }
 
 } // namespace GB
@@ -0,0 +1,374 @@
+#pragma once
+
+#include "concepts.h"
+#include "polynomial.h"
+#include "algorithms.h"
+#include "division.h"
+#include "modular.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace GB {
+
+// Decides whether the set is a Gröbner basis of the ideal it generates without computing one.
+// Pairs are collected as if the elements were added one by one to Buchberger algorithm with
+// the Gebauer-Möller update: criterion M drops a pair (h, g) whose lcm is a proper multiple
+// of the lcm of another new pair (h, g'), F keeps one of the new pairs with equal lcms,
+// the product criterion drops pairs with coprime leading monomials, and criterion B drops
+// an old pair (g1, g2) whose lcm is divisible by LM(h) without being lcm(g1, h) or lcm(g2, h).
+// Only the surviving S-polynomials are reduced, in parallel, until the first non-zero remainder.
+template<SuitableFieldType FieldType, SuitableOrder<Monomial> MonomialOrder>
+bool IsGroebnerBasis(const PolynomialSet<FieldType, MonomialOrder> &set, size_t amountOfThreads = 0) {
+    using PolynomialType = Polynomial<FieldType, MonomialOrder>;
+    using IndexType = size_t;
+
+    std::vector<PolynomialType> basis;
+    for (const auto &polynomial : set) {
+        if (!PolynomialType::IsZero(polynomial)) {
+            basis.push_back(polynomial);
+        }
+    }
+
+    struct Pair {
+        IndexType first;
+        IndexType second;
+        Monomial lcm;
+    };
+    auto leading = [&] (IndexType index) {
+        return basis[index].GetLeadingTerm().first;
+    };
+
+    std::vector<Pair> pairs;
+    for (IndexType added = 0; added < basis.size(); ++added) {
+        std::vector<Pair> candidates;
+        for (IndexType index = 0; index < added; ++index) {
+            candidates.push_back(Pair{index, added, Lcm(leading(index), leading(added))});
+        }
+
+        std::vector<Pair> kept;
+        for (IndexType position = 0; position < candidates.size(); ++position) {
+            const auto &pair = candidates[position];
+            bool isCoprime = leading(pair.first) * leading(pair.second) == pair.lcm;
+            auto dividesLcm = [&] (const Pair &other) {
+                return pair.lcm.IsDivisibleBy(other.lcm);
+            };
+            if (isCoprime || (std::none_of(candidates.begin() + position + 1, candidates.end(), dividesLcm) &&
+                              std::none_of(kept.begin(), kept.end(), dividesLcm))) {
+                kept.push_back(pair);
+            }
+        }
+
+        std::erase_if(pairs, [&] (const Pair &pair) {
+            return pair.lcm.IsDivisibleBy(leading(added)) &&
+                   Lcm(leading(pair.first), leading(added)) != pair.lcm &&
+                   Lcm(leading(pair.second), leading(added)) != pair.lcm;
+        });
+        for (auto &pair : kept) {
+            if (leading(pair.first) * leading(pair.second) != pair.lcm) {
+                pairs.push_back(std::move(pair));
+            }
+        }
+    }
+
+    std::atomic<bool> isRejected = false;
+    std::atomic<size_t> nextPair = 0;
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+    [[maybe_unused]] uint32_t modulus = 0;
+    if constexpr (std::is_same_v<FieldType, RuntimeModular>) {
+        modulus = RuntimeModular::GetCurrentModulus();
+    }
+
+    auto work = [&] {
+        try {
+            // The modulus of RuntimeModular is thread-local, the workers inherit the caller's one.
+            std::optional<RuntimeModular::ModulusScope> scope;
+            if constexpr (std::is_same_v<FieldType, RuntimeModular>) {
+                scope.emplace(modulus);
+            }
+
+            for (size_t index = nextPair++; index < pairs.size() && !isRejected; index = nextPair++) {
+                const auto &pair = pairs[index];
+                auto S = SPolynomialStream(basis[pair.first], basis[pair.second]);
+                if (!PolynomialType::IsZero(HeapReduction(std::move(S), basis))) {
+                    isRejected = true;
+                }
+            }
+        } catch (...) {
+            std::lock_guard lock(exceptionMutex);
+            exception = std::current_exception();
+            isRejected = true;
+        }
+    };
+
+    if (amountOfThreads == 0) {
+        amountOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    amountOfThreads = std::max<size_t>(1, std::min(amountOfThreads, pairs.size()));
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 1; thread < amountOfThreads; ++thread) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    return !isRejected;
+}
+
+struct ModularVerificationOptions {
+    // Accepted probability of certifying a wrong candidate.
+    double errorProbability = 1e-12;
+    // Assumed probability that one random prime misses an error of the candidate. A wrong
+    // candidate passes modulo p only if p divides one of finitely many non-zero integers,
+    // so for 31-bit primes and coefficients of moderate height this is far below the default.
+    double singlePrimeErrorBound = 1e-3;
+    // 0 stands for std::thread::hardware_concurrency().
+    size_t amountOfThreads = 0;
+    // 0 stands for a seed from std::random_device.
+    uint64_t seed = 0;
+    // Primes used by the computation being verified, they prove nothing and are never drawn.
+    std::vector<uint32_t> excludedPrimes;
+};
+
+// Probabilistic certificate of a rational Gröbner basis: the candidate and the generators are
+// mapped modulo several random 31-bit primes, and modulo each prime the candidate has to be
+// a Gröbner basis (all S-pairs reduce to zero), contain the generators in its ideal (they reduce
+// to zero) and lie in the ideal of the generators (it reduces to zero by their basis mod p).
+// Primes dividing a denominator or a leading coefficient are skipped, they would change the
+// leading monomials. The primes are checked in parallel and the first failure stops all threads.
+class ModularVerifier {
+public:
+    static constexpr uint32_t kMinPrime = 1u << 30;
+    static constexpr uint32_t kMaxPrime = (1u << 31) - 1;
+
+    explicit ModularVerifier(ModularVerificationOptions options = {}) : options_(std::move(options)) {
+        if (!(options_.errorProbability > 0 && options_.errorProbability < 1) ||
+            !(options_.singlePrimeErrorBound > 0 && options_.singlePrimeErrorBound < 1)) {
+            throw std::invalid_argument("Probabilities have to lie strictly between 0 and 1");
+        }
+    }
+
+    // Amount of primes needed for the error probability, the candidate passes all of them.
+    [[nodiscard]] size_t GetAmountOfPrimes() const {
+        return static_cast<size_t>(std::ceil(std::log(options_.errorProbability) / std::log(options_.singlePrimeErrorBound)));
+    }
+
+    // Primes used by the last Verify call.
+    [[nodiscard]] const std::vector<uint32_t> &GetPrimes() const noexcept {
+        return primes_;
+    }
+
+    template<SuitableOrder<Monomial> MonomialOrder>
+    bool Verify(const PolynomialSet<Rational<>, MonomialOrder> &candidate,
+                const PolynomialSet<Rational<>, MonomialOrder> &generators)
+    {
+        primes_ = DrawPrimes_(candidate, generators);
+
+        std::atomic<bool> isRejected = false;
+        std::atomic<size_t> nextPrime = 0;
+        std::exception_ptr exception;
+        std::mutex exceptionMutex;
+
+        auto work = [&] {
+            try {
+                for (size_t index = nextPrime++; index < primes_.size() && !isRejected; index = nextPrime++) {
+                    if (!CheckModulo_(candidate, generators, primes_[index])) {
+                        isRejected = true;
+                    }
+                }
+            } catch (...) {
+                std::lock_guard lock(exceptionMutex);
+                exception = std::current_exception();
+                isRejected = true;
+            }
+        };
+
+        size_t amountOfThreads = options_.amountOfThreads != 0 ? options_.amountOfThreads :
+                                 std::max(1u, std::thread::hardware_concurrency());
+        amountOfThreads = std::min(amountOfThreads, primes_.size());
+
+        std::vector<std::thread> threads;
+        for (size_t thread = 1; thread < amountOfThreads; ++thread) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+
+        return !isRejected;
+    }
+
+    // Deterministic Miller-Rabin, the bases 2, 3, 5, 7 are enough below 3215031751.
+    static bool IsPrime(uint32_t value) noexcept {
+        if (value < 2) {
+            return false;
+        }
+        for (uint32_t divisor : {2u, 3u, 5u, 7u}) {
+            if (value % divisor == 0) {
+                return value == divisor;
+            }
+        }
+
+        uint32_t odd = value - 1;
+        int twos = 0;
+        while (odd % 2 == 0) {
+            odd /= 2;
+            ++twos;
+        }
+
+        auto multiply = [value] (uint64_t lhs, uint64_t rhs) {
+            return lhs * rhs % value;
+        };
+
+        for (uint64_t base : {2u, 3u, 5u, 7u}) {
+            uint64_t power = 1;
+            for (uint64_t exponent = odd, square = base; exponent != 0; exponent >>= 1, square = multiply(square, square)) {
+                if (exponent & 1) {
+                    power = multiply(power, square);
+                }
+            }
+
+            if (power == 1 || power == value - 1) {
+                continue;
+            }
+            bool isWitness = true;
+            for (int step = 1; step < twos && isWitness; ++step) {
+                power = multiply(power, power);
+                isWitness = power != value - 1;
+            }
+            if (isWitness) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    template<SuitableOrder<Monomial> MonomialOrder>
+    std::vector<uint32_t> DrawPrimes_(const PolynomialSet<Rational<>, MonomialOrder> &candidate,
+                                      const PolynomialSet<Rational<>, MonomialOrder> &generators) const
+    {
+        std::mt19937_64 generator(options_.seed != 0 ? options_.seed : std::random_device()());
+        std::uniform_int_distribution<uint32_t> distribution(kMinPrime, kMaxPrime);
+
+        auto isSuitable = [&] (uint32_t prime) {
+            auto divides = [prime] (int64_t value) {
+                return value % static_cast<int64_t>(prime) == 0;
+            };
+
+            for (const auto *set : {&candidate, &generators}) {
+                for (const auto &polynomial : *set) {
+                    for (const auto &[monomial, coefficient] : polynomial) {
+                        if (divides(coefficient.GetDenominator())) {
+                            return false;
+                        }
+                    }
+                }
+            }
+            for (const auto &polynomial : candidate) {
+                if (!Polynomial<Rational<>, MonomialOrder>::IsZero(polynomial) &&
+                    divides(polynomial.GetLeadingTerm().second.GetNumerator())) {
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        std::vector<uint32_t> primes;
+        while (primes.size() < GetAmountOfPrimes()) {
+            uint32_t prime = distribution(generator);
+            if (IsPrime(prime) && isSuitable(prime) &&
+                std::find(primes.begin(), primes.end(), prime) == primes.end() &&
+                std::find(options_.excludedPrimes.begin(), options_.excludedPrimes.end(), prime) == options_.excludedPrimes.end()) {
+                primes.push_back(prime);
+            }
+        }
+
+        return primes;
+    }
+
+    template<SuitableOrder<Monomial> MonomialOrder>
+    static bool CheckModulo_(const PolynomialSet<Rational<>, MonomialOrder> &candidate,
+                             const PolynomialSet<Rational<>, MonomialOrder> &generators,
+                             uint32_t prime)
+    {
+        using PolynomialType = Polynomial<RuntimeModular, MonomialOrder>;
+        RuntimeModular::ModulusScope scope(prime);
+
+        auto toModular = [] (const PolynomialSet<Rational<>, MonomialOrder> &set) {
+            std::vector<PolynomialType> result;
+            for (const auto &polynomial : set) {
+                PolynomialType image;
+                for (const auto &[monomial, coefficient] : polynomial) {
+                    image.PushBackTerm(monomial, RuntimeModular(coefficient.GetNumerator()) /
+                                                 RuntimeModular(coefficient.GetDenominator()));
+                }
+                if (!PolynomialType::IsZero(image)) {
+                    result.push_back(std::move(image));
+                }
+            }
+            return result;
+        };
+
+        auto basis = toModular(candidate);
+        auto images = toModular(generators);
+
+        if (!IsGroebnerBasis(PolynomialSet<RuntimeModular, MonomialOrder>(basis.begin(), basis.end()), 1)) {
+            return false;
+        }
+
+        for (const auto &image : images) {
+            if (!PolynomialType::IsZero(HeapReduction(image, basis))) {
+                return false;
+            }
+        }
+
+        PolynomialSet<RuntimeModular, MonomialOrder> generatorsBasis(images.begin(), images.end());
+        BuhbergerAlgorithm(generatorsBasis);
+        for (const auto &element : basis) {
+            if (!PolynomialType::IsZero(HeapReduction(element, generatorsBasis))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    ModularVerificationOptions options_;
+    std::vector<uint32_t> primes_;
+};
+
+template<SuitableOrder<Monomial> MonomialOrder>
+bool VerifyModularly(const PolynomialSet<Rational<>, MonomialOrder> &candidate,
+                     const PolynomialSet<Rational<>, MonomialOrder> &generators,
+                     ModularVerificationOptions options = {})
+{
+    return ModularVerifier(std::move(options)).Verify(candidate, generators);
+}
+
+} // namespace GB